@@ -0,0 +1,81 @@
+#include "anomaly_detector.h"
+#include <algorithm>
+#include <cmath>
+
+const char* anomalyKindName(AnomalyKind kind) {
+    switch (kind) {
+        case ANOMALY_BURST: return "burst";
+        case ANOMALY_DROP: return "drop";
+        case ANOMALY_SHIFT_UP: return "shift_up";
+        case ANOMALY_SHIFT_DOWN: return "shift_down";
+        default: return "unknown";
+    }
+}
+
+AnomalyDetector::AnomalyDetector(const DetectorParameters& parameters)
+    : parameters(parameters), mean(0.0), variance(0.0), cusum_high(0.0), cusum_low(0.0),
+      clean_value(0.0), observations(0), total_events(0), kind_counts() {}
+
+void AnomalyDetector::learn(double residual, double weight) {
+    // Pembaruan inkremental rata-rata dan varians berbobot eksponensial
+    double difference = residual - mean;
+    double increment = weight * difference;
+    mean += increment;
+    variance = (1.0 - weight) * (variance + difference * increment);
+}
+
+void AnomalyDetector::record(double timestamp, AnomalyKind kind, double value, double baseline,
+                             double score) {
+    events.push_back({timestamp, kind, value, baseline, score});
+    if (events.size() > parameters.max_events) events.pop_front();
+    total_events++;
+    kind_counts[kind]++;
+}
+
+size_t AnomalyDetector::observe(double timestamp, double value, double expected) {
+    double residual = value - expected;
+    clean_value = value;
+    observations++;
+    if (observations == 1) {
+        mean = residual;
+        return 0;
+    }
+    // Selama pemanasan bobot 1/n membuat baseline sama dengan rata-rata biasa
+    double weight = std::max(parameters.alpha, 1.0 / observations);
+    if (observations <= parameters.warmup) {
+        learn(residual, weight);
+        return 0;
+    }
+
+    size_t before = total_events;
+    double baseline = expected + mean;
+    double floor = parameters.min_stddev_ratio * std::fabs(expected);
+    double stddev = std::max({std::sqrt(variance), floor, 1e-12});
+    double z = (residual - mean) / stddev;
+    if (z > parameters.threshold) {
+        record(timestamp, ANOMALY_BURST, value, baseline, z);
+    } else if (z < -parameters.threshold) {
+        record(timestamp, ANOMALY_DROP, value, baseline, z);
+    }
+
+    // CUSUM atas z yang dibatasi: satu lonjakan saja tidak cukup untuk
+    // melewati batas, tetapi beberapa interval menyimpang berturut-turut cukup
+    double bounded = std::min(std::max(z, -parameters.threshold), parameters.threshold);
+    cusum_high = std::max(0.0, cusum_high + bounded - parameters.cusum_slack);
+    cusum_low = std::max(0.0, cusum_low - bounded - parameters.cusum_slack);
+    if (cusum_high > parameters.cusum_limit || cusum_low > parameters.cusum_limit) {
+        bool up = cusum_high > parameters.cusum_limit;
+        record(timestamp, up ? ANOMALY_SHIFT_UP : ANOMALY_SHIFT_DOWN, value, baseline,
+               up ? cusum_high : cusum_low);
+        // Pelajari ulang dari interval berikutnya; varians dipertahankan
+        observations = 0;
+        cusum_high = 0.0;
+        cusum_low = 0.0;
+        return total_events - before;
+    }
+
+    clean_value = expected + mean + bounded * stddev;
+    if (std::fabs(z) <= parameters.threshold) clean_value = value;
+    learn(mean + bounded * stddev, weight);
+    return total_events - before;
+}
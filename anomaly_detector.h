@@ -0,0 +1,81 @@
+#ifndef ANOMALY_DETECTOR_H
+#define ANOMALY_DETECTOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <deque>
+
+enum AnomalyKind {
+    ANOMALY_BURST,        // Satu interval jauh di atas baseline
+    ANOMALY_DROP,         // Satu interval jauh di bawah baseline
+    ANOMALY_SHIFT_UP,     // Level naik secara berkelanjutan (CUSUM)
+    ANOMALY_SHIFT_DOWN,   // Level turun secara berkelanjutan (CUSUM)
+    ANOMALY_KIND_COUNT
+};
+
+const char* anomalyKindName(AnomalyKind kind);
+
+struct AnomalyEvent {
+    double timestamp;      // Awal interval tempat anomali terdeteksi
+    AnomalyKind kind;
+    double value;          // Bandwidth interval (Mbps)
+    double baseline;       // Nilai yang diharapkan: ramalan musiman + rata-rata EWMA residual
+    double score;          // Skor z; untuk pergeseran level, nilai CUSUM
+};
+
+struct DetectorParameters {
+    double alpha = 0.05;            // Bobot EWMA/EWMV (rentang efektif ~2/alpha interval)
+    double threshold = 4.0;         // Ambang |z| untuk lonjakan dan penurunan
+    double cusum_slack = 0.5;       // k: penyimpangan yang dianggap normal (dalam simpangan baku)
+    double cusum_limit = 8.0;       // h: ambang CUSUM untuk pergeseran level
+    double min_stddev_ratio = 0.02; // Simpangan baku minimum relatif terhadap nilai harapan
+    size_t warmup = 24;             // Interval awal yang hanya membangun baseline residual
+    size_t max_events = 1024;       // Peristiwa terbaru yang disimpan
+};
+
+// Detektor daring atas deret interval. Setiap interval dibandingkan dengan
+// nilai harapan dari model musiman; residualnya dilacak dengan rata-rata dan
+// varians EWMA. Lonjakan/penurunan berasal dari skor z satu interval dan
+// pergeseran level dari CUSUM dua sisi atas skor z yang dibatasi. Pola
+// harian sendiri tidak memicu peristiwa karena sudah ada dalam nilai harapan.
+// Residual ekstrem dipangkas ke ambang sebelum memperbarui baseline, dan
+// getCleanValue() memberi nilai terpangkas yang sama untuk model musiman,
+// agar satu lonjakan tidak mencemari keduanya. Setelah pergeseran level
+// detektor kembali ke pemanasan sehingga level baru dipelajari apa adanya.
+// Memori tetap (O(1) per interval, riwayat peristiwa dibatasi max_events)
+// dan setiap interval dinilai saat ditambahkan.
+class AnomalyDetector {
+public:
+    explicit AnomalyDetector(const DetectorParameters& parameters = DetectorParameters());
+
+    // Nilai satu interval terhadap nilai harapannya; mengembalikan jumlah
+    // peristiwa baru (0-2)
+    size_t observe(double timestamp, double value, double expected);
+
+    // Nilai interval terakhir untuk memperbarui model musiman
+    double getCleanValue() const { return clean_value; }
+
+    const std::deque<AnomalyEvent>& getEvents() const { return events; }   // Terlama lebih dulu
+    size_t getEventCount() const { return total_events; }   // Termasuk yang sudah dibuang
+    size_t getEventCount(AnomalyKind kind) const { return kind_counts[kind]; }
+    double getResidualMean() const { return mean; }
+    double getResidualStddev() const { return std::sqrt(variance); }
+    const DetectorParameters& getParameters() const { return parameters; }
+
+private:
+    DetectorParameters parameters;
+    double mean;                  // EWMA residual
+    double variance;              // EWMV residual
+    double cusum_high;
+    double cusum_low;
+    double clean_value;
+    size_t observations;          // Sejak pemanasan terakhir
+    std::deque<AnomalyEvent> events;
+    size_t total_events;
+    size_t kind_counts[ANOMALY_KIND_COUNT];
+
+    void record(double timestamp, AnomalyKind kind, double value, double baseline, double score);
+    void learn(double residual, double weight);
+};
+
+#endif // ANOMALY_DETECTOR_H
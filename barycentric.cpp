@@ -0,0 +1,119 @@
+#include "barycentric.h"
+#include <algorithm>
+#include <cmath>
+
+BarycentricInterpolator::BarycentricInterpolator()
+    : center(0.0), scale(1.0), degree(0) {
+}
+
+void BarycentricInterpolator::clear() {
+    nodes.clear();
+    weights.clear();
+    weighted_values.clear();
+    values.clear();
+}
+
+bool BarycentricInterpolator::build(const double* x, const double* y, size_t n,
+                                    int requested_degree) {
+    clear();
+    if (n == 0) return false;
+
+    int max_degree = static_cast<int>(n) - 1;
+    degree = (requested_degree < 0 || requested_degree > max_degree) ? max_degree : requested_degree;
+
+    // Skalakan ke interval panjang 4 (kapasitas 1) agar hasil kali tetap dalam jangkauan double
+    double lo = *std::min_element(x, x + n);
+    double hi = *std::max_element(x, x + n);
+    center = 0.5 * (lo + hi);
+    scale = (hi > lo) ? 4.0 / (hi - lo) : 1.0;
+
+    nodes.resize(n);
+    for (size_t j = 0; j < n; j++) {
+        nodes[j] = (x[j] - center) * scale;
+    }
+    values.assign(y, y + n);
+
+    // Bobot Floater-Hormann: w_k = sum_{i in J_k} (-1)^i prod_{j=i..i+d, j!=k} 1/(x_k - x_j)
+    weights.assign(n, 0.0);
+    int count = static_cast<int>(n);
+    for (int k = 0; k < count; k++) {
+        int i_begin = std::max(0, k - degree);
+        int i_end = std::min(k, count - 1 - degree);
+        double sum = 0.0;
+        for (int i = i_begin; i <= i_end; i++) {
+            double term = 1.0;
+            for (int j = i; j <= i + degree; j++) {
+                if (j != k) term /= (nodes[k] - nodes[j]);
+            }
+            sum += (i % 2 == 0) ? term : -term;
+        }
+        weights[k] = sum;
+    }
+
+    weighted_values.resize(n);
+    for (size_t j = 0; j < n; j++) {
+        weighted_values[j] = weights[j] * values[j];
+    }
+    return true;
+}
+
+double BarycentricInterpolator::evaluate(double x) const {
+    double result;
+    evaluate(&x, &result, 1);
+    return result;
+}
+
+void BarycentricInterpolator::evaluate(const double* targets, double* results, size_t count) const {
+    const size_t BLOCK = 256;
+    const size_t n = nodes.size();
+    if (n == 0) {
+        std::fill(results, results + count, 0.0);
+        return;
+    }
+
+    double scaled[BLOCK], numerator[BLOCK], denominator[BLOCK], product[BLOCK];
+
+    for (size_t block_start = 0; block_start < count; block_start += BLOCK) {
+        size_t m = std::min(BLOCK, count - block_start);
+
+        for (size_t t = 0; t < m; t++) {
+            scaled[t] = (targets[block_start + t] - center) * scale;
+            numerator[t] = 0.0;
+            denominator[t] = 0.0;
+            product[t] = 1.0;
+        }
+
+        // Rekurensi tanpa pembagian; baris dalam bebas ketergantungan antar target
+        for (size_t j = 0; j < n; j++) {
+            const double node = nodes[j];
+            const double w = weights[j];
+            const double wy = weighted_values[j];
+            for (size_t t = 0; t < m; t++) {
+                double diff = scaled[t] - node;
+                numerator[t] = numerator[t] * diff + wy * product[t];
+                denominator[t] = denominator[t] * diff + w * product[t];
+                product[t] *= diff;
+            }
+        }
+
+        for (size_t t = 0; t < m; t++) {
+            double value = numerator[t] / denominator[t];
+            // Cadangan untuk deret sangat panjang di mana hasil kali underflow/overflow
+            if (!std::isfinite(value)) value = evaluateDivided(scaled[t]);
+            results[block_start + t] = value;
+        }
+    }
+}
+
+double BarycentricInterpolator::evaluateDivided(double scaled_x) const {
+    // Bentuk barisentrik kedua klasik
+    double numerator = 0.0, denominator = 0.0;
+    for (size_t j = 0; j < nodes.size(); j++) {
+        double diff = scaled_x - nodes[j];
+        if (diff == 0.0) return values[j];
+        double c = weights[j] / diff;
+        numerator += c * values[j];
+        denominator += c;
+    }
+    return numerator / denominator;
+}
@@ -0,0 +1,54 @@
+#ifndef BARYCENTRIC_H
+#define BARYCENTRIC_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Mesin interpolasi Lagrange dalam bentuk barisentrik.
+//
+// Bobot dihitung sekali per pemuatan data (O(n * d^2)). Dengan derajat
+// d = n - 1 hasilnya adalah polinom Lagrange klasik melalui semua titik;
+// dengan d lebih kecil bobot Floater-Hormann memadukan polinom Lagrange
+// lokal berderajat d sehingga tidak terjadi osilasi Runge pada titik
+// berjarak sama (misalnya jam 0..23).
+//
+// Evaluasi memakai rekurensi tanpa pembagian:
+//   num = num * (x - x_j) + w_j * y_j * P,  den = den * (x - x_j) + w_j * P,
+//   P   = P * (x - x_j)
+// sehingga setiap kueri O(n) perkalian-penjumlahan dan satu pembagian akhir.
+class BarycentricInterpolator {
+private:
+    std::vector<double> nodes;          // Titik x yang sudah diskalakan
+    std::vector<double> weights;        // w_j
+    std::vector<double> weighted_values; // w_j * y_j
+    std::vector<double> values;
+    double center;
+    double scale;                       // Skala agar hasil kali (x - x_j) tidak overflow
+    int degree;
+
+public:
+    BarycentricInterpolator();
+
+    // degree < 0 atau >= n - 1 berarti polinom Lagrange global
+    bool build(const double* x, const double* y, size_t n, int degree);
+    bool build(const std::vector<double>& x, const std::vector<double>& y, int degree) {
+        return build(x.data(), y.data(), std::min(x.size(), y.size()), degree);
+    }
+    void clear();
+
+    bool empty() const { return nodes.empty(); }
+    size_t size() const { return nodes.size(); }
+    int getDegree() const { return degree; }
+
+    double evaluate(double x) const;
+
+    // Evaluasi banyak titik sekaligus; loop dalam berjalan di atas target
+    // yang bersebelahan sehingga dapat divektorisasi oleh kompiler
+    void evaluate(const double* targets, double* results, size_t count) const;
+
+private:
+    double evaluateDivided(double scaled_x) const;
+};
+
+#endif // BARYCENTRIC_H
@@ -0,0 +1,747 @@
+#include "batch_cli.h"
+#include "buffered_writer.h"
+#include "metrics.h"
+#include "multi_capture.h"
+#include "network_analyzer.h"
+#include "query_server.h"
+#include <charconv>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BatchOptions {
+    std::string command;
+    std::string input;            // CSV mentah; kosong = muat file biner
+    std::string binary;           // File biner terproses
+    std::string output;           // Kosong = stdout
+    std::string mode = "mmap";    // getline, mmap, atau parallel
+    std::string format = "csv";   // csv atau json
+    std::string metrics_json;     // Kosong = tidak diekspor
+    std::string metrics_prometheus;
+    unsigned threads = 0;
+    double interval = 0.0;        // 0 = bawaan analyzer
+    double max_gap = 0.0;         // 0 = bawaan analyzer
+    double tolerance = 1e-6;      // Galat absolut integrasi adaptif (Mbps×jam)
+    bool has_degree = false;
+    int degree = 3;
+    bool unix_time = false;
+    std::string socket_path;      // serve: soket domain Unix
+    int port = -1;                // serve: port TCP localhost
+    std::vector<std::string> arguments;
+};
+
+void printUsage() {
+    std::cerr << "Penggunaan: network_analyzer <perintah> [opsi] [argumen]\n"
+              << "\n"
+              << "Perintah:\n"
+              << "  ingest               Muat CSV mentah (--input) dan simpan file biner\n"
+              << "  stats                Statistik deret interval dan tabel per jam\n"
+              << "  predict T...         Interpolasi pada jam T (0-24), atau timestamp Unix dengan --unix\n"
+              << "  integrate A B ...    Integral Simpson untuk setiap pasangan jam [A, B]\n"
+              << "  export               Tulis tabel 24 jam ke CSV (--output wajib)\n"
+              << "  export-series        Tulis satu baris per interval: bandwidth, paket, interpolasi,\n"
+              << "                         dan integral kumulatif; --format json menghasilkan JSON Lines\n"
+              << "  query-file FILE      Jalankan kueri dari FILE, satu per baris:\n"
+              << "                         predict <jam> | predict-unix <timestamp>\n"
+              << "                         integrate <jam_awal> <jam_akhir> | percentile <p>\n"
+              << "                         integrate-adaptive <jam_awal> <jam_akhir>\n"
+              << "                         integrate-unix <timestamp_awal> <timestamp_akhir>\n"
+              << "  anomalies            Lonjakan, penurunan, dan pergeseran level per interval\n"
+              << "  aggregate A B ...    Min, maks, rata-rata, volume, dan paket untuk setiap pasangan\n"
+              << "                         timestamp Unix [A, B)\n"
+              << "  rollup L [A B]       Ember rollup L (5m, 1h, atau 1d), opsional dibatasi ke [A, B)\n"
+              << "  serve                Muat data sekali lalu layani kueri predict/integrate/stats\n"
+              << "                         lewat --socket atau --port sampai SIGINT/SIGTERM\n"
+              << "  analyze-captures P...  Analisis banyak CSV mentah atau pcap bersamaan (direktori atau glob),\n"
+              << "                         satu baris per file ditambah baris gabungan\n"
+              << "\n"
+              << "Opsi:\n"
+              << "  --input FILE         Muat CSV mentah (boleh gzip/zstd) atau capture pcap/pcapng\n"
+              << "                       alih-alih file biner\n"
+              << "  --binary FILE        File biner terproses (bawaan: data/processed/...bin)\n"
+              << "  --mode M             Mode muat CSV mentah: getline, mmap (bawaan), parallel;\n"
+              << "                       file pcap/pcapng selalu dimuat lewat mmap\n"
+              << "  --threads N          Jumlah thread untuk mode parallel dan analyze-captures (0 = otomatis)\n"
+              << "  --interval S         Lebar interval agregasi dalam detik (1-3600)\n"
+              << "  --max-gap S          Celah timestamp terjauh (detik) yang masih memperluas array\n"
+              << "                       ember; interval lebih jauh disimpan terpisah (bawaan 7 hari)\n"
+              << "  --degree D           Derajat interpolasi Lagrange (-1 = global)\n"
+              << "  --tolerance T        Toleransi galat integrasi adaptif (bawaan 1e-6 Mbps×jam)\n"
+              << "  --format F           Format keluaran: csv (bawaan) atau json\n"
+              << "  --output FILE        Tulis hasil ke FILE alih-alih stdout\n"
+              << "  --unix               predict memakai timestamp Unix atas deret penuh\n"
+              << "  --socket PATH        serve: dengarkan pada soket domain Unix PATH\n"
+              << "  --port N             serve: dengarkan pada 127.0.0.1:N (0 = port acak)\n"
+              << "  --metrics-json FILE  Tulis metrik kinerja sebagai JSON setelah perintah selesai\n"
+              << "  --metrics-prom FILE  Tulis metrik kinerja dalam format teks Prometheus\n";
+}
+
+bool parseNumber(const std::string& text, double& value) {
+    const char* first = text.data();
+    const char* last = first + text.size();
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+
+bool parseOptions(int argc, char** argv, BatchOptions& options) {
+    options.command = argv[1];
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            options.arguments.push_back(arg);
+            continue;
+        }
+        if (arg == "--unix") {
+            options.unix_time = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Error: Opsi " << arg << " membutuhkan nilai." << std::endl;
+            return false;
+        }
+        std::string value = argv[++i];
+        double number = 0.0;
+        if (arg == "--input") {
+            options.input = value;
+        } else if (arg == "--binary") {
+            options.binary = value;
+        } else if (arg == "--output") {
+            options.output = value;
+        } else if (arg == "--mode") {
+            options.mode = value;
+        } else if (arg == "--format") {
+            options.format = value;
+        } else if (arg == "--metrics-json") {
+            options.metrics_json = value;
+        } else if (arg == "--metrics-prom") {
+            options.metrics_prometheus = value;
+        } else if (arg == "--socket") {
+            options.socket_path = value;
+        } else if (arg == "--port" && parseNumber(value, number) && number >= 0 && number <= 65535) {
+            options.port = static_cast<int>(number);
+        } else if (arg == "--threads" && parseNumber(value, number) && number >= 0) {
+            options.threads = static_cast<unsigned>(number);
+        } else if (arg == "--tolerance" && parseNumber(value, number) && number > 0) {
+            options.tolerance = number;
+        } else if (arg == "--interval" && parseNumber(value, number)) {
+            options.interval = number;
+        } else if (arg == "--max-gap" && parseNumber(value, number) && number > 0) {
+            options.max_gap = number;
+        } else if (arg == "--degree" && parseNumber(value, number)) {
+            options.has_degree = true;
+            options.degree = static_cast<int>(number);
+        } else {
+            std::cerr << "Error: Opsi atau nilai tidak valid: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if (options.format != "csv" && options.format != "json") {
+        std::cerr << "Error: Format keluaran harus csv atau json." << std::endl;
+        return false;
+    }
+    if (options.mode != "getline" && options.mode != "mmap" && options.mode != "parallel") {
+        std::cerr << "Error: Mode muat harus getline, mmap, atau parallel." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Pesan status analyzer ditulis ke std::cout; selama perintah batch berjalan
+// pesan tersebut dialihkan ke stderr agar stdout hanya berisi hasil
+class StatusToStderr {
+private:
+    std::streambuf* saved;
+
+public:
+    StatusToStderr() : saved(std::cout.rdbuf(std::cerr.rdbuf())) {}
+    ~StatusToStderr() { std::cout.rdbuf(saved); }
+};
+
+// Menyusun hasil dalam satu buffer dan menulisnya sekali di akhir.
+// CSV: baris header dari nama kolom baris pertama. JSON: array objek.
+class ResultWriter {
+private:
+    bool json;
+    std::string buffer;
+    std::string header;
+    std::string row;
+    size_t rows;
+    size_t columns_in_row;
+
+    void appendName(const std::string& name) {
+        if (columns_in_row > 0) row += ',';
+        if (json) {
+            appendQuoted(row, name);
+            row += ':';
+        } else if (rows == 0) {
+            if (columns_in_row > 0) header += ',';
+            header += name;
+        }
+        columns_in_row++;
+    }
+
+    void appendQuoted(std::string& out, const std::string& text) {
+        out += '"';
+        for (char c : text) {
+            if (c == '"') {
+                out += json ? "\\\"" : "\"\"";
+            } else if (json && c == '\\') {
+                out += "\\\\";
+            } else if (json && static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                out += escaped;
+            } else {
+                out += c;
+            }
+        }
+        out += '"';
+    }
+
+public:
+    explicit ResultWriter(bool json) : json(json), rows(0), columns_in_row(0) {
+        buffer.reserve(1 << 16);
+    }
+
+    void field(const std::string& name, double value) {
+        appendName(name);
+        if (!std::isfinite(value)) {
+            if (json) row += "null";
+            return;
+        }
+        char text[MAX_NUMBER_CHARS];
+        row.append(text, formatNumber(text, value));
+    }
+
+    void field(const std::string& name, long long value) {
+        appendName(name);
+        char text[24];
+        auto result = std::to_chars(text, text + sizeof(text), value);
+        row.append(text, result.ptr);
+    }
+
+    void field(const std::string& name, const std::string& value) {
+        appendName(name);
+        bool needs_quotes = json || value.find_first_of(",\"\n") != std::string::npos;
+        if (needs_quotes) {
+            appendQuoted(row, value);
+        } else {
+            row += value;
+        }
+    }
+
+    void endRow() {
+        if (json) {
+            buffer += rows == 0 ? "[\n  {" : ",\n  {";
+            buffer += row;
+            buffer += '}';
+        } else {
+            if (rows == 0) {
+                buffer += header;
+                buffer += '\n';
+            }
+            buffer += row;
+            buffer += '\n';
+        }
+        row.clear();
+        columns_in_row = 0;
+        rows++;
+    }
+
+    bool flush(const std::string& path) {
+        if (json) buffer += rows == 0 ? "[]\n" : "\n]\n";
+
+        if (path.empty()) {
+            std::fwrite(buffer.data(), 1, buffer.size(), stdout);
+            std::fflush(stdout);
+            return true;
+        }
+        std::ofstream out(path, std::ios::binary);
+        if (!out.is_open()) {
+            std::cerr << "Error: Tidak dapat menulis file " << path << std::endl;
+            return false;
+        }
+        out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        return static_cast<bool>(out);
+    }
+};
+
+bool loadData(NetworkAnalyzer& analyzer, const BatchOptions& options) {
+    if (options.interval > 0.0 && !analyzer.setIntervalDuration(options.interval)) {
+        return false;
+    }
+    if (options.max_gap > 0.0) analyzer.setMaxTimestampGap(options.max_gap);
+
+    bool loaded;
+    if (options.input.empty()) {
+        loaded = analyzer.loadProcessedBinary(options.binary);
+    } else if (options.mode == "getline") {
+        loaded = analyzer.loadRawData(options.input);
+    } else if (options.mode == "parallel") {
+        loaded = analyzer.loadRawDataParallel(options.input, options.threads);
+    } else {
+        loaded = analyzer.loadCapture(options.input);
+    }
+
+    if (loaded && options.has_degree) {
+        analyzer.setLagrangeDegree(options.degree);
+    }
+    return loaded;
+}
+
+bool parseArguments(const std::vector<std::string>& arguments, std::vector<double>& values) {
+    for (const std::string& arg : arguments) {
+        double value;
+        if (!parseNumber(arg, value)) {
+            std::cerr << "Error: Argumen bukan angka: " << arg << std::endl;
+            return false;
+        }
+        values.push_back(value);
+    }
+    return true;
+}
+
+void writeStatistics(ResultWriter& writer, const std::string& scope,
+                     const TrafficStatistics& stats, double p50, double p95, double p99) {
+    writer.field("scope", scope);
+    writer.field("count", static_cast<long long>(stats.count));
+    writer.field("min_mbps", stats.min);
+    writer.field("max_mbps", stats.max);
+    writer.field("mean_mbps", stats.mean);
+    writer.field("stddev_mbps", stats.stddev);
+    writer.field("peak_to_average", stats.peak_to_average);
+    writer.field("p50_mbps", p50);
+    writer.field("p95_mbps", p95);
+    writer.field("p99_mbps", p99);
+    writer.endRow();
+}
+
+int runStats(NetworkAnalyzer& analyzer, ResultWriter& writer) {
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    if (analyzer.getDataSize() > 0) {
+        writeStatistics(writer, "series", analyzer.getSeriesStatistics(), analyzer.getPercentile(50),
+                        analyzer.getPercentile(95), analyzer.getPercentile(99));
+    }
+    writeStatistics(writer, "hourly", analyzer.getStatistics(), none, none, none);
+    return 0;
+}
+
+int runAnomalies(NetworkAnalyzer& analyzer, ResultWriter& writer) {
+    if (analyzer.getDataSize() == 0) {
+        std::cerr << "Error: Deret interval kosong; muat data mentah atau biner." << std::endl;
+        return 1;
+    }
+    for (const AnomalyEvent& event : analyzer.getAnomalies()) {
+        writer.field("timestamp", event.timestamp);
+        writer.field("kind", std::string(anomalyKindName(event.kind)));
+        writer.field("bandwidth_mbps", event.value);
+        writer.field("baseline_mbps", event.baseline);
+        writer.field("score", event.score);
+        writer.endRow();
+    }
+    return 0;
+}
+
+void writeAggregate(ResultWriter& writer, const RangeAggregate& window, double interval_duration) {
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    bool empty = window.count == 0;
+    writer.field("intervals", static_cast<long long>(window.count));
+    writer.field("min_mbps", empty ? none : window.min);
+    writer.field("max_mbps", empty ? none : window.max);
+    writer.field("mean_mbps", empty ? none : window.mean());
+    writer.field("volume_mbps_hours", window.volume(interval_duration));
+    writer.field("packets", window.packets);
+    writer.endRow();
+}
+
+int runAggregate(NetworkAnalyzer& analyzer, const BatchOptions& options, ResultWriter& writer) {
+    std::vector<double> bounds;
+    if (!parseArguments(options.arguments, bounds)) return 2;
+    if (bounds.empty() || bounds.size() % 2 != 0) {
+        std::cerr << "Error: aggregate membutuhkan pasangan timestamp Unix awal dan akhir." << std::endl;
+        return 2;
+    }
+    for (size_t i = 0; i < bounds.size(); i += 2) {
+        writer.field("start", bounds[i]);
+        writer.field("end", bounds[i + 1]);
+        writeAggregate(writer, analyzer.aggregateRange(bounds[i], bounds[i + 1]),
+                       analyzer.getIntervalDuration());
+    }
+    return 0;
+}
+
+int runRollup(NetworkAnalyzer& analyzer, const BatchOptions& options, ResultWriter& writer) {
+    RollupLevel level;
+    std::vector<double> bounds;
+    if (options.arguments.empty() || !parseRollupLevel(options.arguments[0], level)) {
+        std::cerr << "Error: rollup membutuhkan tingkat 5m, 1h, atau 1d." << std::endl;
+        return 2;
+    }
+    std::vector<std::string> rest(options.arguments.begin() + 1, options.arguments.end());
+    if (!parseArguments(rest, bounds)) return 2;
+    if (bounds.size() != 0 && bounds.size() != 2) {
+        std::cerr << "Error: rollup menerima paling banyak satu pasangan timestamp [A, B)." << std::endl;
+        return 2;
+    }
+
+    std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+    const RollupSeries& rollup = snapshot->getRollup(level);
+    for (size_t i = 0; i < rollup.size(); i++) {
+        double start = rollup.bucketStart(i);
+        if (!bounds.empty() && (start < bounds[0] || start >= bounds[1])) continue;
+        writer.field("bucket_start", start);
+        writeAggregate(writer, rollup.bucket(i), analyzer.getIntervalDuration());
+    }
+    return 0;
+}
+
+int runPredict(NetworkAnalyzer& analyzer, const BatchOptions& options, ResultWriter& writer) {
+    std::vector<double> times;
+    if (!parseArguments(options.arguments, times)) return 2;
+    if (options.unix_time && analyzer.getDataSize() == 0) {
+        std::cerr << "Error: Deret interval kosong; muat data mentah atau biner." << std::endl;
+        return 1;
+    }
+
+    std::vector<double> values = options.unix_time ? analyzer.interpolateAt(times)
+                                                   : analyzer.lagrangeInterpolation(times);
+    for (size_t i = 0; i < times.size(); i++) {
+        writer.field(options.unix_time ? "unix_time" : "hour", times[i]);
+        writer.field("bandwidth_mbps", values[i]);
+        writer.endRow();
+    }
+    return 0;
+}
+
+int runIntegrate(NetworkAnalyzer& analyzer, const BatchOptions& options, ResultWriter& writer) {
+    std::vector<double> bounds;
+    if (!parseArguments(options.arguments, bounds)) return 2;
+    if (bounds.size() % 2 != 0) {
+        std::cerr << "Error: integrate membutuhkan pasangan jam awal dan akhir." << std::endl;
+        return 2;
+    }
+
+    std::vector<std::pair<double, double>> ranges;
+    for (size_t i = 0; i < bounds.size(); i += 2) {
+        ranges.push_back({bounds[i], bounds[i + 1]});
+    }
+    std::vector<double> values = analyzer.simpsonIntegrationBatch(ranges);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        writer.field("start_hour", ranges[i].first);
+        writer.field("end_hour", ranges[i].second);
+        writer.field("consumption_mbps_hours", values[i]);
+        writer.endRow();
+    }
+    return 0;
+}
+
+// Kueri dikelompokkan per jenis lalu dijawab lewat API batch;
+// hasil tetap ditulis dalam urutan baris file
+int runQueryFile(NetworkAnalyzer& analyzer, const BatchOptions& options, ResultWriter& writer) {
+    if (options.arguments.size() != 1) {
+        std::cerr << "Error: query-file membutuhkan tepat satu file kueri." << std::endl;
+        return 2;
+    }
+    std::ifstream file(options.arguments[0]);
+    if (!file.is_open()) {
+        std::cerr << "Error: Tidak dapat membuka file kueri " << options.arguments[0] << std::endl;
+        return 1;
+    }
+
+    enum QueryType { PREDICT, PREDICT_UNIX, INTEGRATE, INTEGRATE_ADAPTIVE, INTEGRATE_UNIX, PERCENTILE };
+    struct Query {
+        size_t line;
+        QueryType type;
+        double a;
+        double b;
+        size_t slot;   // Posisi dalam batch jenisnya
+    };
+    static const char* const QUERY_NAMES[] = {"predict", "predict-unix", "integrate", "integrate-adaptive",
+                                              "integrate-unix", "percentile"};
+
+    std::vector<Query> queries;
+    std::vector<double> hours, unix_times;
+    std::vector<std::pair<double, double>> ranges;
+    size_t invalid = 0;
+    std::string line;
+
+    for (size_t line_number = 1; std::getline(file, line); line_number++) {
+        std::istringstream tokens(line);
+        std::string name, first, second, extra;
+        tokens >> name;
+        if (name.empty() || name[0] == '#') continue;
+        tokens >> first >> second >> extra;
+
+        Query query = {line_number, PREDICT, 0.0, 0.0, 0};
+        bool valid = parseNumber(first, query.a);
+        if (name == "integrate" || name == "integrate-adaptive" || name == "integrate-unix") {
+            query.type = name == "integrate" ? INTEGRATE
+                       : name == "integrate-adaptive" ? INTEGRATE_ADAPTIVE : INTEGRATE_UNIX;
+            valid = valid && parseNumber(second, query.b) && extra.empty();
+        } else {
+            valid = valid && second.empty();
+            if (name == "predict") {
+                query.type = PREDICT;
+            } else if (name == "predict-unix") {
+                query.type = PREDICT_UNIX;
+            } else if (name == "percentile") {
+                query.type = PERCENTILE;
+            } else {
+                valid = false;
+            }
+        }
+        if (!valid) {
+            std::cerr << "Error: Kueri tidak valid pada baris " << line_number << ": " << line << std::endl;
+            invalid++;
+            continue;
+        }
+
+        if (query.type == PREDICT) {
+            query.slot = hours.size();
+            hours.push_back(query.a);
+        } else if (query.type == PREDICT_UNIX) {
+            query.slot = unix_times.size();
+            unix_times.push_back(query.a);
+        } else if (query.type == INTEGRATE) {
+            query.slot = ranges.size();
+            ranges.push_back({query.a, query.b});
+        }
+        queries.push_back(query);
+    }
+
+    std::vector<double> hour_values = analyzer.lagrangeInterpolation(hours);
+    std::vector<double> unix_values;
+    if (!unix_times.empty()) {
+        if (analyzer.getDataSize() == 0) {
+            unix_values.assign(unix_times.size(), std::numeric_limits<double>::quiet_NaN());
+        } else {
+            unix_values = analyzer.interpolateAt(unix_times);
+        }
+    }
+    std::vector<double> range_values = analyzer.simpsonIntegrationBatch(ranges);
+
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    for (const Query& query : queries) {
+        double value = 0.0;
+        IntegrationResult adaptive;
+        adaptive.error_estimate = none;
+        switch (query.type) {
+            case PREDICT:      value = hour_values[query.slot]; break;
+            case PREDICT_UNIX: value = unix_values[query.slot]; break;
+            case INTEGRATE:    value = range_values[query.slot]; break;
+            case INTEGRATE_ADAPTIVE:
+                adaptive = analyzer.integrateAdaptive(query.a, query.b, options.tolerance);
+                value = adaptive.value;
+                break;
+            case INTEGRATE_UNIX:
+                adaptive = analyzer.integrateSeriesAdaptive(query.a, query.b, options.tolerance);
+                value = adaptive.value;
+                break;
+            case PERCENTILE:   value = analyzer.getPercentile(query.a); break;
+        }
+        bool has_end = query.type == INTEGRATE || query.type == INTEGRATE_ADAPTIVE ||
+                       query.type == INTEGRATE_UNIX;
+        writer.field("line", static_cast<long long>(query.line));
+        writer.field("query", QUERY_NAMES[query.type]);
+        writer.field("a", query.a);
+        writer.field("b", has_end ? query.b : none);
+        writer.field("value", value);
+        writer.field("error_estimate", adaptive.error_estimate);
+        writer.endRow();
+    }
+
+    std::cerr << queries.size() << " kueri dijawab";
+    if (invalid > 0) std::cerr << ", " << invalid << " baris tidak valid dilewati";
+    std::cerr << "." << std::endl;
+    return invalid > 0 ? 1 : 0;
+}
+
+void writeCaptureRow(ResultWriter& writer, const std::string& scope, bool ok, size_t intervals,
+                     long long packets, const TrafficStatistics& stats, double p50, double p95,
+                     double p99, double consumption, double seconds) {
+    writer.field("scope", scope);
+    writer.field("ok", static_cast<long long>(ok ? 1 : 0));
+    writer.field("intervals", static_cast<long long>(intervals));
+    writer.field("packets", packets);
+    writer.field("min_mbps", stats.min);
+    writer.field("max_mbps", stats.max);
+    writer.field("mean_mbps", stats.mean);
+    writer.field("stddev_mbps", stats.stddev);
+    writer.field("p50_mbps", p50);
+    writer.field("p95_mbps", p95);
+    writer.field("p99_mbps", p99);
+    writer.field("consumption_mbps_hours", consumption);
+    writer.field("seconds", seconds);
+    writer.endRow();
+}
+
+int runAnalyzeCaptures(const BatchOptions& options, ResultWriter& writer) {
+    if (options.arguments.empty()) {
+        std::cerr << "Error: analyze-captures membutuhkan direktori atau pola glob." << std::endl;
+        return 2;
+    }
+    std::vector<std::string> files;
+    for (const std::string& pattern : options.arguments) {
+        std::vector<std::string> matched = listCaptures(pattern);
+        files.insert(files.end(), matched.begin(), matched.end());
+    }
+
+    MultiCaptureReport report;
+    double interval = options.interval > 0.0 ? options.interval : 300.0;
+    if (!analyzeCaptures(files, report, interval, options.threads)) return 1;
+
+    for (const CaptureSummary& summary : report.captures) {
+        writeCaptureRow(writer, summary.path, summary.ok, summary.intervals, summary.packets,
+                        summary.stats, summary.p50, summary.p95, summary.p99,
+                        summary.consumption, summary.seconds);
+    }
+    writeCaptureRow(writer, "combined", report.failed == 0, report.stats.count, report.packets,
+                    report.stats, report.p50, report.p95, report.p99,
+                    report.consumption, report.wall_seconds);
+    std::cerr << report.captures.size() - report.failed << " dari " << report.captures.size()
+              << " file dianalisis dengan " << report.threads << " thread dalam "
+              << report.wall_seconds << " s." << std::endl;
+    return report.failed > 0 ? 1 : 0;
+}
+
+QueryServer* active_server = nullptr;
+
+void stopActiveServer(int) {
+    if (active_server) active_server->stop();
+}
+
+int runServe(NetworkAnalyzer& analyzer, const BatchOptions& options) {
+    ServerOptions server_options;
+    server_options.socket_path = options.socket_path;
+    server_options.port = options.port;
+    server_options.tolerance = options.tolerance;
+
+    QueryServer server(analyzer, server_options);
+    if (!server.start()) return 1;
+    active_server = &server;
+    std::signal(SIGINT, stopActiveServer);
+    std::signal(SIGTERM, stopActiveServer);
+
+    std::cerr << analyzer.getDataSize() << " interval dimuat; melayani kueri pada ";
+    if (!options.socket_path.empty()) std::cerr << options.socket_path;
+    else std::cerr << "127.0.0.1:" << server.getPort();
+    std::cerr << std::endl;
+
+    bool ok = server.run();
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    active_server = nullptr;
+
+    const ServerStatistics& stats = server.getStatistics();
+    std::cerr << "Server berhenti: " << stats.requests << " permintaan dalam " << stats.batches
+              << " batch (terbesar " << stats.largest_batch << "), " << stats.errors << " tidak valid, "
+              << stats.connections_accepted << " koneksi";
+    if (stats.latency_us.count() > 0) {
+        std::cerr << "; latensi p50 " << stats.latency_us.quantile(0.50) << " us, p95 "
+                  << stats.latency_us.quantile(0.95) << " us, p99 " << stats.latency_us.quantile(0.99) << " us";
+    }
+    std::cerr << "." << std::endl;
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int runBatchCommand(int argc, char** argv, const std::string& default_binary_path) {
+    BatchOptions options;
+    options.binary = default_binary_path;
+
+    std::string command = argc > 1 ? argv[1] : "";
+    if (command == "help" || command == "--help" || command == "-h") {
+        printUsage();
+        return 0;
+    }
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    StatusToStderr redirect;
+    NetworkAnalyzer analyzer;
+    ResultWriter writer(options.format == "json");
+    int status;
+
+    if (options.command == "ingest") {
+        if (options.input.empty()) {
+            std::cerr << "Error: ingest membutuhkan --input." << std::endl;
+            return 2;
+        }
+        if (!loadData(analyzer, options) || !analyzer.saveProcessedBinary(options.binary)) return 1;
+        writer.field("intervals", static_cast<long long>(analyzer.getDataSize()));
+        writer.field("interval_seconds", analyzer.getIntervalDuration());
+        writer.field("binary", options.binary);
+        writer.endRow();
+        status = 0;
+    } else if (options.command == "export") {
+        if (options.output.empty()) {
+            std::cerr << "Error: export membutuhkan --output." << std::endl;
+            return 2;
+        }
+        if (!loadData(analyzer, options)) return 1;
+        status = analyzer.saveProcessedData(options.output) ? 0 : 1;
+    } else if (options.command == "export-series") {
+        if (!loadData(analyzer, options)) return 1;
+        ExportFormat format = options.format == "json" ? EXPORT_JSONL : EXPORT_CSV;
+        status = analyzer.exportResults(options.output, format) ? 0 : 1;
+    } else if (options.command == "stats" || options.command == "predict" ||
+               options.command == "integrate" || options.command == "query-file" ||
+               options.command == "anomalies" || options.command == "aggregate" ||
+               options.command == "rollup") {
+        if (!loadData(analyzer, options)) return 1;
+        if (options.command == "stats") {
+            status = runStats(analyzer, writer);
+        } else if (options.command == "anomalies") {
+            status = runAnomalies(analyzer, writer);
+        } else if (options.command == "aggregate") {
+            status = runAggregate(analyzer, options, writer);
+        } else if (options.command == "rollup") {
+            status = runRollup(analyzer, options, writer);
+        } else if (options.command == "predict") {
+            status = runPredict(analyzer, options, writer);
+        } else if (options.command == "integrate") {
+            status = runIntegrate(analyzer, options, writer);
+        } else {
+            status = runQueryFile(analyzer, options, writer);
+        }
+        if (status == 2) return status;
+    } else if (options.command == "serve") {
+        if (options.socket_path.empty() == (options.port < 0)) {
+            std::cerr << "Error: serve membutuhkan tepat satu dari --socket atau --port." << std::endl;
+            return 2;
+        }
+        if (!loadData(analyzer, options)) return 1;
+        status = runServe(analyzer, options);
+    } else if (options.command == "analyze-captures") {
+        status = runAnalyzeCaptures(options, writer);
+        if (status == 2) return status;
+    } else {
+        std::cerr << "Error: Perintah tidak dikenal: " << options.command << std::endl;
+        printUsage();
+        return 2;
+    }
+
+    // Perintah ekspor menulis filenya sendiri dan serve menjawab lewat soket;
+    // perintah lain menulis buffer hasil
+    bool exported = options.command == "export" || options.command == "export-series" ||
+                    options.command == "serve";
+    if (!exported && !writer.flush(options.output)) status = 1;
+    if (!options.metrics_json.empty() && !metrics::writeJson(options.metrics_json)) status = 1;
+    if (!options.metrics_prometheus.empty() && !metrics::writePrometheus(options.metrics_prometheus)) {
+        status = 1;
+    }
+    return status;
+}
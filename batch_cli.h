@@ -0,0 +1,20 @@
+#ifndef BATCH_CLI_H
+#define BATCH_CLI_H
+
+#include <string>
+
+// Mode non-interaktif: subperintah baris perintah untuk skrip dan pipeline.
+//
+//   network_analyzer ingest    --input raw.csv [--mode mmap] [--binary out.bin]
+//   network_analyzer stats     [--input raw.csv | --binary file.bin]
+//   network_analyzer predict   8.5 12.5 ...        (jam 0-24, atau --unix untuk timestamp Unix)
+//   network_analyzer integrate 0 6 18 24 ...      (pasangan jam awal dan akhir)
+//   network_analyzer export    --output file.csv
+//   network_analyzer query-file queries.txt
+//
+// Data dimuat sekali per proses. Hasil ditulis ke stdout (atau --output) dalam
+// CSV atau JSON (--format) lewat satu buffer; pesan status dialihkan ke stderr.
+// Mengembalikan kode keluar proses: 0 sukses, 1 gagal, 2 penggunaan salah.
+int runBatchCommand(int argc, char** argv, const std::string& default_binary_path);
+
+#endif // BATCH_CLI_H
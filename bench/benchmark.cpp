@@ -0,0 +1,400 @@
+// Benchmark tahap-tahap utama analyzer atas capture sintetis yang deterministik.
+//
+//   benchmark [--rows N] [--seed S] [--input FILE] [--keep] [--repeat R]
+//             [--queries Q] [--threads T] [--csv FILE] [--generate-only FILE]
+//             [--format csv|pcap|pcapng]
+//
+// --format memilih format file untuk --generate-only. Tanpa --input, capture
+// yang sama juga ditulis sebagai pcap untuk tahap load_pcap, dan (jika
+// dibangun dengan zlib) sebagai CSV gzip untuk tahap load_gzip. Throughput
+// load_gzip dihitung terhadap ukuran CSV tanpa kompresi.
+//
+// Setiap tahap dilaporkan sebagai throughput dan persentil latensi
+// (p50/p95/p99). --csv menulis hasil yang sama dalam format yang mudah
+// dibandingkan dengan baseline dari commit sebelumnya.
+#include "capture_generator.h"
+#include "mapped_file.h"
+#include "network_analyzer.h"
+#include "raw_csv.h"
+#include "traffic_aggregator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <streambuf>
+#include <string>
+#include <vector>
+#ifdef NA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Paket yang diurai sebelumnya untuk mengukur agregasi tanpa biaya penguraian
+const size_t MAX_AGGREGATE_SAMPLE = 16u << 20;
+
+struct StageResult {
+    std::string name;
+    double operations_per_run = 0;   // Baris, kueri, atau panggilan per pengulangan
+    double bytes_per_run = 0;        // 0 jika tidak relevan
+    std::vector<double> latencies;   // Detik per operasi yang diukur
+    double total_seconds = 0;
+    double total_operations = 0;
+};
+
+// Pesan status analyzer tidak ikut diukur maupun ditampilkan
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+class QuietCout {
+private:
+    NullBuffer null_buffer;
+    std::streambuf* saved;
+
+public:
+    QuietCout() : saved(std::cout.rdbuf(&null_buffer)) {}
+    ~QuietCout() { std::cout.rdbuf(saved); }
+};
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+    return values[rank == 0 ? 0 : rank - 1];
+}
+
+// Jalankan body sebanyak repeat kali; setiap pengulangan adalah satu sampel latensi
+StageResult timeRuns(const std::string& name, int repeat, double operations, double bytes,
+                     const std::function<void()>& body) {
+    StageResult result;
+    result.name = name;
+    result.operations_per_run = operations;
+    result.bytes_per_run = bytes;
+    for (int r = 0; r < repeat; r++) {
+        auto start = Clock::now();
+        body();
+        double seconds = secondsSince(start);
+        result.latencies.push_back(seconds);
+        result.total_seconds += seconds;
+        result.total_operations += operations;
+    }
+    return result;
+}
+
+// Ukur setiap panggilan secara terpisah; latensi per kueri
+StageResult timeCalls(const std::string& name, size_t count, const std::function<void(size_t)>& call) {
+    StageResult result;
+    result.name = name;
+    result.operations_per_run = 1;
+    result.latencies.reserve(count);
+    auto begin = Clock::now();
+    for (size_t i = 0; i < count; i++) {
+        auto start = Clock::now();
+        call(i);
+        result.latencies.push_back(secondsSince(start));
+    }
+    result.total_seconds = secondsSince(begin);
+    result.total_operations = static_cast<double>(count);
+    return result;
+}
+
+void printResults(const std::vector<StageResult>& results) {
+    std::printf("\n%-22s %14s %10s %12s %12s %12s\n", "Tahap", "Operasi/s", "MB/s",
+                "p50 (us)", "p95 (us)", "p99 (us)");
+    std::printf("%s\n", std::string(86, '-').c_str());
+    for (const StageResult& stage : results) {
+        double seconds = std::max(stage.total_seconds, 1e-12);
+        double runs = stage.total_operations / std::max(stage.operations_per_run, 1.0);
+        double mb_per_s = stage.bytes_per_run * runs / seconds / 1e6;
+        std::printf("%-22s %14.0f %10.2f %12.3f %12.3f %12.3f\n", stage.name.c_str(),
+                    stage.total_operations / seconds, mb_per_s,
+                    percentile(stage.latencies, 50) * 1e6, percentile(stage.latencies, 95) * 1e6,
+                    percentile(stage.latencies, 99) * 1e6);
+    }
+}
+
+bool writeResultsCsv(const std::string& path, const std::vector<StageResult>& results,
+                     const CaptureSpec& spec) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "Error: Tidak dapat menulis file " << path << std::endl;
+        return false;
+    }
+    std::fprintf(file, "stage,rows,seed,ops_per_s,mb_per_s,p50_us,p95_us,p99_us\n");
+    for (const StageResult& stage : results) {
+        double seconds = std::max(stage.total_seconds, 1e-12);
+        double runs = stage.total_operations / std::max(stage.operations_per_run, 1.0);
+        std::fprintf(file, "%s,%llu,%llu,%.1f,%.3f,%.3f,%.3f,%.3f\n", stage.name.c_str(),
+                     static_cast<unsigned long long>(spec.rows),
+                     static_cast<unsigned long long>(spec.seed),
+                     stage.total_operations / seconds, stage.bytes_per_run * runs / seconds / 1e6,
+                     percentile(stage.latencies, 50) * 1e6, percentile(stage.latencies, 95) * 1e6,
+                     percentile(stage.latencies, 99) * 1e6);
+    }
+    std::fclose(file);
+    return true;
+}
+
+#ifdef NA_HAVE_ZLIB
+// Kompres file dengan level gzip bawaan, seperti arsip capture pada umumnya
+bool gzipFile(const std::string& source, const std::string& destination) {
+    FILE* in = std::fopen(source.c_str(), "rb");
+    gzFile out = gzopen(destination.c_str(), "wb6");
+    bool ok = in && out;
+    std::vector<char> buffer(1 << 20);
+    while (ok) {
+        size_t got = std::fread(buffer.data(), 1, buffer.size(), in);
+        if (got == 0) break;
+        ok = gzwrite(out, buffer.data(), static_cast<unsigned>(got)) == static_cast<int>(got);
+    }
+    if (in) std::fclose(in);
+    if (out && gzclose(out) != Z_OK) ok = false;
+    if (!ok) std::cerr << "Error: Gagal menulis file " << destination << std::endl;
+    return ok;
+}
+#endif
+
+void printUsage() {
+    std::cerr << "Penggunaan: benchmark [--rows N] [--seed S] [--input FILE] [--keep]\n"
+              << "                 [--repeat R] [--queries Q] [--threads T] [--csv FILE]\n"
+              << "                 [--generate-only FILE] [--format csv|pcap|pcapng]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CaptureSpec spec;
+    std::string input;
+    std::string csv_path;
+    std::string generate_only;
+    std::string pcap_input;
+    std::string gzip_input;
+    CaptureFormat generate_format = CAPTURE_CSV;
+    bool keep = false;
+    int repeat = 5;
+    size_t query_count = 100000;
+    unsigned threads = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--keep") {
+            keep = true;
+        } else if (arg == "--rows" && has_value) {
+            spec.rows = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--seed" && has_value) {
+            spec.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--input" && has_value) {
+            input = argv[++i];
+        } else if (arg == "--repeat" && has_value) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--queries" && has_value) {
+            query_count = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && has_value) {
+            threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--csv" && has_value) {
+            csv_path = argv[++i];
+        } else if (arg == "--generate-only" && has_value) {
+            generate_only = argv[++i];
+        } else if (arg == "--format" && has_value) {
+            std::string format = argv[++i];
+            if (format == "csv") {
+                generate_format = CAPTURE_CSV;
+            } else if (format == "pcap") {
+                generate_format = CAPTURE_PCAP;
+            } else if (format == "pcapng") {
+                generate_format = CAPTURE_PCAPNG;
+            } else {
+                printUsage();
+                return 2;
+            }
+        } else {
+            printUsage();
+            return 2;
+        }
+    }
+
+    std::vector<StageResult> results;
+
+    // Tahap 0: pembangkitan capture sintetis
+    if (input.empty()) {
+        input = generate_only.empty() ? "bench_capture.csv" : generate_only;
+        std::cout << "Membangkitkan " << spec.rows << " baris (seed " << spec.seed << ") ke "
+                  << input << "..." << std::endl;
+        if (!generate_only.empty()) spec.format = generate_format;
+        uint64_t bytes = 0;
+        results.push_back(timeRuns("generate", 1, static_cast<double>(spec.rows), 0, [&]() {
+            bytes = writeSyntheticCapture(input, spec);
+        }));
+        if (bytes == 0) return 1;
+        results.back().bytes_per_run = static_cast<double>(bytes);
+        if (!generate_only.empty()) {
+            printResults(results);
+            return 0;
+        }
+
+        CaptureSpec pcap_spec = spec;
+        pcap_spec.format = CAPTURE_PCAP;
+        pcap_input = "bench_capture.pcap";
+        if (writeSyntheticCapture(pcap_input, pcap_spec) == 0) return 1;
+#ifdef NA_HAVE_ZLIB
+        gzip_input = "bench_capture.csv.gz";
+        if (!gzipFile(input, gzip_input)) return 1;
+#endif
+    } else {
+        keep = true;   // Jangan pernah menghapus file milik pengguna
+    }
+
+    MappedFile file;
+    if (!file.open(input)) {
+        std::cerr << "Error: Tidak dapat membuka file " << input << std::endl;
+        return 1;
+    }
+    double file_bytes = static_cast<double>(file.size());
+    const char* body = raw_csv::nextLine(file.begin(), file.end());
+
+    // Pemindaian pemanasan: menghitung baris dan memuat file ke page cache
+    // sehingga semua tahap diukur dalam kondisi cache yang sama
+    size_t rows = raw_csv::scan(body, file.end(), [](double, int) {}).rows;
+
+    // Tahap 1: penguraian saja (batas atas untuk semua mode ingest)
+    results.push_back(timeRuns("parse", repeat, static_cast<double>(rows), file_bytes, [&]() {
+        raw_csv::scan(body, file.end(), [](double, int) {});
+    }));
+    std::cout << "Capture: " << rows << " baris, " << file_bytes / 1e6 << " MB" << std::endl;
+
+    // Tahap 2: agregasi interval atas paket yang sudah diurai
+    std::vector<double> timestamps;
+    std::vector<int> lengths;
+    timestamps.reserve(std::min(rows, MAX_AGGREGATE_SAMPLE));
+    lengths.reserve(std::min(rows, MAX_AGGREGATE_SAMPLE));
+    raw_csv::scan(body, file.end(), [&](double timestamp, int length) {
+        if (timestamps.size() < MAX_AGGREGATE_SAMPLE) {
+            timestamps.push_back(timestamp);
+            lengths.push_back(length);
+        }
+    });
+    size_t intervals = 0;
+    results.push_back(timeRuns("aggregate", repeat, static_cast<double>(timestamps.size()), 0, [&]() {
+        TrafficAggregator aggregator(300.0);
+        for (size_t i = 0; i < timestamps.size(); i++) {
+            aggregator.addPacket(timestamps[i], lengths[i]);
+        }
+        intervals = aggregator.emitAll([](double, long long, long long) {});
+    }));
+    std::vector<double>().swap(timestamps);
+    std::vector<int>().swap(lengths);
+
+    // Tahap 3: ingest ujung ke ujung untuk setiap mode pemuatan
+    NetworkAnalyzer analyzer;
+    {
+        QuietCout quiet;
+        results.push_back(timeRuns("load_getline", repeat, static_cast<double>(rows), file_bytes,
+                                   [&]() { analyzer.loadRawData(input); }));
+        results.push_back(timeRuns("load_mmap", repeat, static_cast<double>(rows), file_bytes,
+                                   [&]() { analyzer.loadRawDataMapped(input); }));
+        results.push_back(timeRuns("load_parallel", repeat, static_cast<double>(rows), file_bytes,
+                                   [&]() { analyzer.loadRawDataParallel(input, threads); }));
+        if (!pcap_input.empty()) {
+            MappedFile pcap;
+            double pcap_bytes = pcap.open(pcap_input) ? static_cast<double>(pcap.size()) : 0.0;
+            results.push_back(timeRuns("load_pcap", repeat, static_cast<double>(rows), pcap_bytes,
+                                       [&]() { analyzer.loadPcap(pcap_input); }));
+        }
+        if (!gzip_input.empty()) {
+            results.push_back(timeRuns("load_gzip", repeat, static_cast<double>(rows), file_bytes,
+                                       [&]() { analyzer.loadRawDataCompressed(gzip_input); }));
+        }
+    }
+    std::cout << "Deret: " << analyzer.getDataSize() << " interval (agregasi mandiri: "
+              << intervals << ")" << std::endl;
+
+    // Tahap 4: kueri numerik dengan target acak yang deterministik
+    std::vector<double> hours(query_count), unix_times(query_count);
+    std::vector<std::pair<double, double>> ranges(query_count), windows(query_count);
+    std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+    const TimeSeriesStore& series = snapshot->getSeries();
+    double series_start = series.empty() ? 0.0 : series.firstTimestamp();
+    double series_span = series.empty() ? 0.0 : series.lastTimestamp() - series_start;
+    uint64_t state = spec.seed;
+    auto next_uniform = [&state]() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<double>(state >> 11) * (1.0 / 9007199254740992.0);
+    };
+    for (size_t i = 0; i < query_count; i++) {
+        hours[i] = 24.0 * next_uniform();
+        unix_times[i] = series_start + series_span * next_uniform();
+        double a = 20.0 * next_uniform();
+        ranges[i] = {a, a + 3.0 + (21.0 - a) * next_uniform()};
+        double w = series_start + series_span * next_uniform();
+        windows[i] = {w, w + (series_start + series_span - w) * next_uniform()};
+    }
+
+    volatile double sink = 0.0;
+    {
+        QuietCout quiet;
+        results.push_back(timeCalls("lagrange", query_count, [&](size_t i) {
+            sink = sink + analyzer.lagrangeInterpolation(hours[i]);
+        }));
+        results.push_back(timeRuns("lagrange_batch", repeat, static_cast<double>(query_count), 0, [&]() {
+            sink = sink + analyzer.lagrangeInterpolation(hours).back();
+        }));
+        if (!series.empty()) {
+            results.push_back(timeRuns("interpolate_unix_batch", repeat, static_cast<double>(query_count), 0,
+                                       [&]() { sink = sink + analyzer.interpolateAt(unix_times).back(); }));
+        }
+        if (!series.empty()) {
+            results.push_back(timeCalls("range_aggregate", query_count, [&](size_t i) {
+                sink = sink + analyzer.aggregateRange(windows[i].first, windows[i].second).sum;
+            }));
+        }
+        results.push_back(timeCalls("simpson", query_count, [&](size_t i) {
+            sink = sink + analyzer.simpsonIntegration(ranges[i].first, ranges[i].second);
+        }));
+        results.push_back(timeRuns("simpson_batch", repeat, static_cast<double>(query_count), 0, [&]() {
+            sink = sink + analyzer.simpsonIntegrationBatch(ranges).back();
+        }));
+    }
+
+    // Tahap 5: ekspor resolusi penuh; operasi = interval, MB/s = byte keluaran
+    if (!series.empty()) {
+        QuietCout quiet;
+        const std::string export_path = "bench_export.tmp";
+        double csv_bytes = 0.0, jsonl_bytes = 0.0;
+        results.push_back(timeRuns("export_csv", repeat, static_cast<double>(series.size()), 0, [&]() {
+            analyzer.exportResults(export_path, EXPORT_CSV);
+        }));
+        MappedFile exported;
+        if (exported.open(export_path)) csv_bytes = static_cast<double>(exported.size());
+        exported.close();
+        results.back().bytes_per_run = csv_bytes;
+        results.push_back(timeRuns("export_jsonl", repeat, static_cast<double>(series.size()), 0, [&]() {
+            analyzer.exportResults(export_path, EXPORT_JSONL);
+        }));
+        if (exported.open(export_path)) jsonl_bytes = static_cast<double>(exported.size());
+        exported.close();
+        results.back().bytes_per_run = jsonl_bytes;
+        std::remove(export_path.c_str());
+    }
+
+    printResults(results);
+    if (!csv_path.empty() && writeResultsCsv(csv_path, results, spec)) {
+        std::cout << "Hasil benchmark ditulis ke " << csv_path << std::endl;
+    }
+
+    file.close();
+    if (!keep) {
+        std::remove(input.c_str());
+        if (!pcap_input.empty()) std::remove(pcap_input.c_str());
+        if (!gzip_input.empty()) std::remove(gzip_input.c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+#include "capture_generator.h"
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// SplitMix64: cepat, deterministik, dan cukup untuk data uji
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Seragam dalam [0, 1)
+    double uniform() {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+};
+
+struct ProtocolMix {
+    const char* name;
+    double cumulative;   // Probabilitas kumulatif
+    int min_length;
+    int max_length;
+    uint8_t ip_protocol; // Protokol transport dalam frame pcap
+};
+
+const ProtocolMix PROTOCOLS[] = {
+    {"TCP", 0.55, 60, 1500, 6},
+    {"UDP", 0.75, 60, 1400, 17},
+    {"TLSv1.2", 0.90, 100, 1500, 6},
+    {"DNS", 0.97, 60, 512, 17},
+    {"ICMP", 1.00, 64, 98, 1},
+};
+
+// Field biner ditulis little-endian agar file identik di semua platform
+char* put16(char* out, uint16_t value) {
+    out[0] = static_cast<char>(value & 0xFF);
+    out[1] = static_cast<char>(value >> 8);
+    return out + 2;
+}
+
+char* put32(char* out, uint32_t value) {
+    for (int i = 0; i < 4; i++) out[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    return out + 4;
+}
+
+char* putZeros(char* out, size_t count) {
+    std::memset(out, 0, count);
+    return out + count;
+}
+
+size_t transportHeaderLength(uint8_t ip_protocol) {
+    return ip_protocol == 6 ? 20 : 8;
+}
+
+// Ethernet + IPv4 + header transport (isi nol); panjang hasil = bagian yang ditangkap
+char* appendFrame(char* out, const ProtocolMix& protocol, uint32_t source, uint32_t destination,
+                  int length) {
+    static const unsigned char MACS[12] = {0x02, 0, 0, 0, 0, 0x02, 0x02, 0, 0, 0, 0, 0x01};
+    std::memcpy(out, MACS, sizeof(MACS));
+    out += sizeof(MACS);
+    *out++ = 0x08;   // Ethertype IPv4 (big-endian)
+    *out++ = 0x00;
+
+    uint16_t ip_length = static_cast<uint16_t>(length - 14);
+    unsigned char ip[20] = {0x45, 0, static_cast<unsigned char>(ip_length >> 8),
+                            static_cast<unsigned char>(ip_length & 0xFF), 0, 0, 0x40, 0, 64,
+                            protocol.ip_protocol, 0, 0,
+                            10, 0, static_cast<unsigned char>((source >> 8) & 0xFF),
+                            static_cast<unsigned char>((source & 0xFF) + 1),
+                            192, 168, static_cast<unsigned char>((destination >> 8) & 0xFF),
+                            static_cast<unsigned char>((destination & 0xFF) + 1)};
+    std::memcpy(out, ip, sizeof(ip));
+    out += sizeof(ip);
+    return putZeros(out, transportHeaderLength(protocol.ip_protocol));
+}
+
+// Header file sebelum paket pertama
+char* appendFileHeader(char* out, CaptureFormat format) {
+    if (format == CAPTURE_PCAP) {
+        out = put32(out, 0xA1B2C3D4);
+        out = put16(out, 2);
+        out = put16(out, 4);
+        out = putZeros(out, 8);          // thiszone, sigfigs
+        out = put32(out, 65535);         // snaplen
+        return put32(out, 1);            // LINKTYPE_ETHERNET
+    }
+    // Section Header Block: panjang section tidak diketahui (-1)
+    out = put32(out, 0x0A0D0D0A);
+    out = put32(out, 28);
+    out = put32(out, 0x1A2B3C4D);
+    out = put16(out, 1);
+    out = put16(out, 0);
+    out = put32(out, 0xFFFFFFFF);
+    out = put32(out, 0xFFFFFFFF);
+    out = put32(out, 28);
+    // Interface Description Block dengan if_tsresol = 6 (mikrodetik)
+    out = put32(out, 1);
+    out = put32(out, 32);
+    out = put16(out, 1);
+    out = put16(out, 0);
+    out = put32(out, 65535);
+    out = put16(out, 9);
+    out = put16(out, 1);
+    *out++ = 6;
+    out = putZeros(out, 3);
+    out = putZeros(out, 4);              // opt_endofopt
+    return put32(out, 32);
+}
+
+// Satu record paket; frame ditulis di tempat lalu header record dilengkapi
+char* appendPacketRecord(char* out, CaptureFormat format, uint64_t microseconds,
+                         const ProtocolMix& protocol, uint32_t source, uint32_t destination,
+                         int length) {
+    size_t header_length = format == CAPTURE_PCAP ? 16 : 28;
+    char* frame = out + header_length;
+    uint32_t captured = static_cast<uint32_t>(
+        appendFrame(frame, protocol, source, destination, length) - frame);
+
+    if (format == CAPTURE_PCAP) {
+        out = put32(out, static_cast<uint32_t>(microseconds / 1000000));
+        out = put32(out, static_cast<uint32_t>(microseconds % 1000000));
+        out = put32(out, captured);
+        put32(out, static_cast<uint32_t>(length));
+        return frame + captured;
+    }
+
+    uint32_t padded = (captured + 3) & ~3u;
+    uint32_t total = 32 + padded;
+    out = put32(out, 6);
+    out = put32(out, total);
+    out = put32(out, 0);                 // interface_id
+    out = put32(out, static_cast<uint32_t>(microseconds >> 32));
+    out = put32(out, static_cast<uint32_t>(microseconds & 0xFFFFFFFF));
+    out = put32(out, captured);
+    put32(out, static_cast<uint32_t>(length));
+    char* end = putZeros(frame + captured, padded - captured);
+    return put32(end, total);
+}
+
+char* appendUnsigned(char* out, uint32_t value) {
+    return std::to_chars(out, out + 10, value).ptr;
+}
+
+// Alamat "prefix.a.b" dari indeks host
+char* appendAddress(char* out, const char* prefix, uint32_t host) {
+    size_t prefix_length = std::strlen(prefix);
+    std::memcpy(out, prefix, prefix_length);
+    out += prefix_length;
+    out = appendUnsigned(out, (host >> 8) & 0xFF);
+    *out++ = '.';
+    return appendUnsigned(out, (host & 0xFF) + 1);
+}
+
+} // namespace
+
+uint64_t writeSyntheticCapture(const std::string& path, const CaptureSpec& spec) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Tidak dapat menulis file " << path << std::endl;
+        return 0;
+    }
+
+    SplitMix64 rng(spec.seed);
+    std::vector<char> buffer(1 << 20);
+    size_t used = 0;
+    uint64_t written = 0;
+
+    auto flush = [&]() {
+        if (used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) return false;
+        written += used;
+        used = 0;
+        return true;
+    };
+
+    if (spec.format == CAPTURE_CSV) {
+        const char header[] = "Timestamp,Source IP,Destination IP,Protocol,Length\n";
+        std::memcpy(buffer.data(), header, sizeof(header) - 1);
+        used = sizeof(header) - 1;
+    } else {
+        used = static_cast<size_t>(appendFileHeader(buffer.data(), spec.format) - buffer.data());
+    }
+
+    // Jarak antar paket eksponensial; lajunya dimodulasi pola harian
+    // (puncak sekitar pukul 14, sepi sekitar pukul 02)
+    double mean_gap = spec.duration_seconds / static_cast<double>(spec.rows ? spec.rows : 1);
+    double timestamp = spec.start_time;
+    bool ok = true;
+
+    for (uint64_t i = 0; i < spec.rows && ok; i++) {
+        double hour = std::fmod(timestamp, 86400.0) / 3600.0;
+        double rate = 1.0 + spec.diurnal_amplitude * std::sin(2.0 * PI * (hour - 8.0) / 24.0);
+        timestamp += -std::log(1.0 - rng.uniform()) * mean_gap / rate;
+
+        double pick = rng.uniform();
+        const ProtocolMix* protocol = &PROTOCOLS[0];
+        while (pick >= protocol->cumulative && protocol + 1 < std::end(PROTOCOLS)) protocol++;
+
+        // Panjang paket bimodal: ACK kecil dan segmen penuh, sisanya seragam
+        int length;
+        double shape = rng.uniform();
+        if (shape < 0.35) {
+            length = protocol->min_length;
+        } else if (shape < 0.70) {
+            length = protocol->max_length;
+        } else {
+            length = protocol->min_length +
+                     static_cast<int>(rng.uniform() * (protocol->max_length - protocol->min_length + 1));
+        }
+
+        // Pangkat tiga dan dua membuat sebagian kecil host mendominasi lalu lintas
+        double u = rng.uniform();
+        uint32_t source = static_cast<uint32_t>(u * u * u * spec.source_hosts);
+        double v = rng.uniform();
+        uint32_t destination = static_cast<uint32_t>(v * v * spec.destination_hosts);
+
+        if (buffer.size() - used < 128 && !flush()) ok = false;
+        char* out = buffer.data() + used;
+        // Semua format memakai mikrodetik bulat yang sama agar CSV dan pcap identik
+        uint64_t microseconds = static_cast<uint64_t>(std::llround(timestamp * 1e6));
+        if (spec.format != CAPTURE_CSV) {
+            out = appendPacketRecord(out, spec.format, microseconds, *protocol, source, destination, length);
+            used = static_cast<size_t>(out - buffer.data());
+            continue;
+        }
+        out = std::to_chars(out, out + 20, microseconds / 1000000).ptr;
+        *out++ = '.';
+        uint32_t fraction = static_cast<uint32_t>(microseconds % 1000000);
+        for (uint32_t digit = 100000; digit > 0; digit /= 10) *out++ = static_cast<char>('0' + fraction / digit % 10);
+        *out++ = ',';
+        out = appendAddress(out, "10.0.", source);
+        *out++ = ',';
+        out = appendAddress(out, "192.168.", destination);
+        *out++ = ',';
+        size_t name_length = std::strlen(protocol->name);
+        std::memcpy(out, protocol->name, name_length);
+        out += name_length;
+        *out++ = ',';
+        out = std::to_chars(out, out + 8, length).ptr;
+        *out++ = '\n';
+        used = static_cast<size_t>(out - buffer.data());
+    }
+
+    ok = ok && flush();
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) {
+        std::cerr << "Error: Gagal menulis file " << path << std::endl;
+        return 0;
+    }
+    return written;
+}
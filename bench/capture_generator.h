@@ -0,0 +1,34 @@
+#ifndef CAPTURE_GENERATOR_H
+#define CAPTURE_GENERATOR_H
+
+#include <cstdint>
+#include <string>
+
+enum CaptureFormat {
+    CAPTURE_CSV,      // CSV mentah ala ekspor Wireshark
+    CAPTURE_PCAP,     // pcap klasik, timestamp mikrodetik
+    CAPTURE_PCAPNG    // pcapng: SHB, satu IDB, lalu Enhanced Packet Block
+};
+
+// Parameter capture sintetis. Dengan seed yang sama, file yang dihasilkan
+// identik byte demi byte di semua platform (PRNG dan distribusi ditulis
+// sendiri, tidak bergantung pada implementasi <random>).
+struct CaptureSpec {
+    uint64_t rows = 1000000;
+    uint64_t seed = 42;
+    double start_time = 1700000000.0;   // Timestamp Unix paket pertama
+    double duration_seconds = 86400.0;  // Perkiraan rentang capture
+    double diurnal_amplitude = 0.6;     // 0 = laju paket konstan
+    uint32_t source_hosts = 4096;       // Distribusi miring: sedikit host dominan
+    uint32_t destination_hosts = 256;
+    CaptureFormat format = CAPTURE_CSV;
+};
+
+// Tulis CSV mentah dengan header Timestamp,Source IP,Destination IP,Protocol,Length,
+// atau capture pcap/pcapng (little-endian, Ethernet) berisi paket yang sama:
+// frame dipotong setelah header transport dan orig_len sama dengan kolom
+// Length, timestamp dibulatkan ke mikrodetik seperti pada CSV.
+// Mengembalikan jumlah byte yang ditulis, atau 0 jika gagal.
+uint64_t writeSyntheticCapture(const std::string& path, const CaptureSpec& spec);
+
+#endif // CAPTURE_GENERATOR_H
@@ -0,0 +1,108 @@
+#include "buffered_writer.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+char* formatNumber(char* out, double value) {
+    auto result = std::fabs(value) < 1e15 && value == std::floor(value)
+        ? std::to_chars(out, out + MAX_NUMBER_CHARS, static_cast<long long>(value))
+        : std::to_chars(out, out + MAX_NUMBER_CHARS, value);
+    return result.ptr;
+}
+
+BufferedWriter::BufferedWriter(size_t buffer_size)
+    : buffer(buffer_size < 4096 ? 4096 : buffer_size), used(0), file(nullptr), owns_file(false),
+      failed(false), bytes_written(0), write_calls(0) {}
+
+BufferedWriter::~BufferedWriter() {
+    close();
+}
+
+bool BufferedWriter::open(const std::string& filename) {
+    close();
+    path = filename;
+    used = 0;
+    failed = false;
+    bytes_written = 0;
+    write_calls = 0;
+
+    if (filename.empty() || filename == "-") {
+        std::fflush(stdout);
+        file = stdout;
+        owns_file = false;
+        return true;
+    }
+    file = std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Error: Tidak dapat menulis file " << filename << std::endl;
+        failed = true;
+        return false;
+    }
+    // Buffer sendiri sudah besar; buffer stdio hanya akan menyalin ulang
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    owns_file = true;
+    return true;
+}
+
+bool BufferedWriter::flushBuffer() {
+    if (used == 0) return !failed;
+    if (file && !failed) {
+        write_calls++;
+        if (std::fwrite(buffer.data(), 1, used, file) != used) {
+            std::cerr << "Error: Gagal menulis ke " << (owns_file ? path : "stdout") << std::endl;
+            failed = true;
+        } else {
+            bytes_written += used;
+        }
+    }
+    used = 0;
+    return !failed;
+}
+
+bool BufferedWriter::close() {
+    if (!file) return !failed;
+    flushBuffer();
+    if (owns_file) {
+        if (std::fclose(file) != 0 && !failed) {
+            std::cerr << "Error: Gagal menutup " << path << std::endl;
+            failed = true;
+        }
+    } else {
+        std::fflush(file);
+    }
+    file = nullptr;
+    return !failed;
+}
+
+void BufferedWriter::append(const char* text, size_t size) {
+    if (size > buffer.size() - used) {
+        flushBuffer();
+        if (size > buffer.size()) {
+            // Potongan lebih besar dari buffer ditulis langsung
+            if (file && !failed) {
+                write_calls++;
+                if (std::fwrite(text, 1, size, file) != size) failed = true;
+                else bytes_written += size;
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer.data() + used, text, size);
+    used += size;
+}
+
+void BufferedWriter::appendNumber(double value, const char* non_finite) {
+    if (!std::isfinite(value)) {
+        append(non_finite, std::strlen(non_finite));
+        return;
+    }
+    char* out = reserve(MAX_NUMBER_CHARS);
+    used += static_cast<size_t>(formatNumber(out, value) - out);
+}
+
+void BufferedWriter::appendNumber(long long value) {
+    char* out = reserve(MAX_NUMBER_CHARS);
+    auto result = std::to_chars(out, out + MAX_NUMBER_CHARS, value);
+    used += static_cast<size_t>(result.ptr - out);
+}
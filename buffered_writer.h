@@ -0,0 +1,72 @@
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Cukup untuk double terpendek ("-1.2345678901234567e-308") dan long long
+const size_t MAX_NUMBER_CHARS = 32;
+
+// Format angka berhingga ke out (minimal MAX_NUMBER_CHARS byte) dan kembalikan
+// akhir teksnya. Bilangan bulat (misalnya timestamp Unix) ditulis tanpa
+// notasi ilmiah; selainnya representasi terpendek yang bolak-balik tanpa
+// kehilangan presisi. Dipakai semua keluaran CSV/JSON agar formatnya sama.
+char* formatNumber(char* out, double value);
+
+// Penulis keluaran teks bervolume besar. Angka diformat dengan
+// std::to_chars langsung ke satu buffer besar yang dipakai ulang, dan
+// buffer itu ditulis utuh ke file tanpa buffer stdio tambahan, sehingga
+// jutaan baris hanya butuh beberapa ratus panggilan write. Tidak ada
+// flush per baris; isi baru dijamin tertulis setelah close().
+class BufferedWriter {
+private:
+    std::vector<char> buffer;
+    size_t used;
+    FILE* file;
+    bool owns_file;      // false untuk stdout
+    bool failed;
+    std::string path;
+    uint64_t bytes_written;
+    size_t write_calls;
+
+    bool flushBuffer();
+
+    // Pastikan ada ruang untuk size byte; buffer dikosongkan bila perlu
+    char* reserve(size_t size) {
+        if (buffer.size() - used < size) flushBuffer();
+        return buffer.data() + used;
+    }
+
+public:
+    explicit BufferedWriter(size_t buffer_size = 1 << 20);
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // Nama kosong atau "-" menulis ke stdout
+    bool open(const std::string& filename);
+    bool close();   // Tulis sisa buffer; false jika ada penulisan yang gagal
+
+    void append(const char* text, size_t size);
+    void append(const std::string& text) { append(text.data(), text.size()); }
+    template <size_t N>
+    void append(const char (&literal)[N]) { append(literal, N - 1); }
+    void append(char c) {
+        *reserve(1) = c;
+        used++;
+    }
+
+    // Format formatNumber(); nilai tak hingga/NaN ditulis sebagai non_finite
+    void appendNumber(double value, const char* non_finite = "");
+    void appendNumber(long long value);
+
+    bool good() const { return !failed; }
+    uint64_t getBytesWritten() const { return bytes_written + used; }
+    size_t getWriteCalls() const { return write_calls; }
+};
+
+#endif // BUFFERED_WRITER_H
@@ -0,0 +1,303 @@
+#include "decompression_pipeline.h"
+#include "metrics.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#ifdef NA_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NA_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+// Satu format masukan: read() mengisi buffer dan mengembalikan jumlah byte,
+// 0 di akhir aliran. Galat dilaporkan lewat error dan menghentikan aliran.
+class DecompressionPipeline::Decoder {
+public:
+    virtual ~Decoder() {}
+    virtual size_t read(char* out, size_t capacity, std::string& error) = 0;
+};
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+class PlainDecoder : public DecompressionPipeline::Decoder {
+private:
+    FILE* file;
+
+public:
+    explicit PlainDecoder(FILE* file) : file(file) {}
+    ~PlainDecoder() override { std::fclose(file); }
+
+    size_t read(char* out, size_t capacity, std::string& error) override {
+        size_t got = std::fread(out, 1, capacity, file);
+        if (got < capacity && std::ferror(file)) error = "gagal membaca file";
+        return got;
+    }
+};
+
+#ifdef NA_HAVE_ZLIB
+// gzread menangani file dengan beberapa member gzip (hasil cat a.gz b.gz)
+class GzipDecoder : public DecompressionPipeline::Decoder {
+private:
+    gzFile file;
+
+    // gzerror diawali path file; pemanggil sudah mencetak path sendiri
+    static std::string message(gzFile file) {
+        int code;
+        std::string text = gzerror(file, &code);
+        size_t separator = text.rfind(": ");
+        return code == Z_OK ? std::string() :
+            separator == std::string::npos ? text : text.substr(separator + 2);
+    }
+
+public:
+    explicit GzipDecoder(gzFile file) : file(file) {}
+    ~GzipDecoder() override { gzclose(file); }
+
+    size_t read(char* out, size_t capacity, std::string& error) override {
+        size_t total = 0;
+        while (total < capacity) {
+            unsigned request = static_cast<unsigned>(std::min<size_t>(capacity - total, 1u << 30));
+            int got = gzread(file, out + total, request);
+            if (got <= 0) {
+                // Akhir file sebelum trailer gzip berarti arsip terpotong
+                error = message(file);
+                if (got < 0 && error.empty()) error = "galat gzip";
+                break;
+            }
+            total += static_cast<size_t>(got);
+        }
+        return total;
+    }
+};
+#endif
+
+#ifdef NA_HAVE_ZSTD
+// Aliran zstd; beberapa frame berturut-turut didekompresi berurutan
+class ZstdDecoder : public DecompressionPipeline::Decoder {
+private:
+    FILE* file;
+    ZSTD_DStream* stream;
+    std::vector<char> input;
+    ZSTD_inBuffer in;
+    size_t frame_remaining;   // Hasil terakhir ZSTD_decompressStream; 0 = batas frame
+    bool input_done;
+
+public:
+    explicit ZstdDecoder(FILE* file)
+        : file(file), stream(ZSTD_createDStream()), input(ZSTD_DStreamInSize()),
+          in{input.data(), 0, 0}, frame_remaining(0), input_done(false) {
+        ZSTD_initDStream(stream);
+    }
+    ~ZstdDecoder() override {
+        ZSTD_freeDStream(stream);
+        std::fclose(file);
+    }
+
+    size_t read(char* out, size_t capacity, std::string& error) override {
+        ZSTD_outBuffer output = {out, capacity, 0};
+        while (output.pos < output.size) {
+            if (in.pos == in.size) {
+                if (input_done) break;
+                in.size = std::fread(input.data(), 1, input.size(), file);
+                in.pos = 0;
+                if (in.size == 0) {
+                    input_done = true;
+                    if (std::ferror(file)) error = "gagal membaca file";
+                    else if (frame_remaining != 0) error = "frame zstd terpotong";
+                    break;
+                }
+            }
+            size_t result = ZSTD_decompressStream(stream, &output, &in);
+            if (ZSTD_isError(result)) {
+                error = ZSTD_getErrorName(result);
+                break;
+            }
+            frame_remaining = result;
+        }
+        return output.pos;
+    }
+};
+#endif
+
+} // namespace
+
+Compression detectCompression(const char* begin, const char* end) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(begin);
+    size_t size = static_cast<size_t>(end - begin);
+    if (size >= 2 && p[0] == 0x1F && p[1] == 0x8B) return COMPRESSION_GZIP;
+    if (size >= 4 && p[0] == 0x28 && p[1] == 0xB5 && p[2] == 0x2F && p[3] == 0xFD) return COMPRESSION_ZSTD;
+    return COMPRESSION_NONE;
+}
+
+Compression detectFileCompression(const std::string& filename) {
+    char magic[4];
+    FILE* file = std::fopen(filename.c_str(), "rb");
+    if (!file) return COMPRESSION_NONE;
+    size_t got = std::fread(magic, 1, sizeof(magic), file);
+    std::fclose(file);
+    return detectCompression(magic, magic + got);
+}
+
+bool isCompressionSupported(Compression compression) {
+    switch (compression) {
+        case COMPRESSION_NONE: return true;
+#ifdef NA_HAVE_ZLIB
+        case COMPRESSION_GZIP: return true;
+#endif
+#ifdef NA_HAVE_ZSTD
+        case COMPRESSION_ZSTD: return true;
+#endif
+        default: return false;
+    }
+}
+
+const char* compressionName(Compression compression) {
+    switch (compression) {
+        case COMPRESSION_GZIP: return "gzip";
+        case COMPRESSION_ZSTD: return "zstd";
+        default: return "tanpa kompresi";
+    }
+}
+
+DecompressionPipeline::DecompressionPipeline(size_t chunk_size, size_t queue_depth)
+    : buffers(std::max<size_t>(queue_depth, 2), std::vector<char>(std::max<size_t>(chunk_size, 4096))),
+      finished(true), stopping(false), current(SIZE_MAX), compression(COMPRESSION_NONE),
+      compressed_bytes(0), decompressed_bytes(0), consumer_wait_seconds(0.0),
+      producer_wait_seconds(0.0) {}
+
+DecompressionPipeline::~DecompressionPipeline() {
+    close();
+}
+
+bool DecompressionPipeline::open(const std::string& filename) {
+    close();
+    compression = detectFileCompression(filename);
+    if (!isCompressionSupported(compression)) {
+        std::cerr << "Error: Dukungan " << compressionName(compression)
+                  << " tidak tersedia dalam build ini untuk " << filename << std::endl;
+        return false;
+    }
+
+    switch (compression) {
+#ifdef NA_HAVE_ZLIB
+        case COMPRESSION_GZIP: {
+            gzFile gz = gzopen(filename.c_str(), "rb");
+            if (!gz) {
+                std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+                return false;
+            }
+            gzbuffer(gz, 1 << 18);
+            decoder.reset(new GzipDecoder(gz));
+            break;
+        }
+#endif
+        default: {
+            FILE* file = std::fopen(filename.c_str(), "rb");
+            if (!file) {
+                std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+                return false;
+            }
+#ifdef NA_HAVE_ZSTD
+            if (compression == COMPRESSION_ZSTD) {
+                decoder.reset(new ZstdDecoder(file));
+                break;
+            }
+#endif
+            decoder.reset(new PlainDecoder(file));
+            break;
+        }
+    }
+
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(filename, ec);
+    compressed_bytes = ec ? 0 : size;
+    decompressed_bytes = 0;
+    consumer_wait_seconds = 0.0;
+    producer_wait_seconds = 0.0;
+    error.clear();
+
+    free_buffers.clear();
+    filled_buffers.clear();
+    for (size_t i = 0; i < buffers.size(); i++) free_buffers.push_back(i);
+    current = SIZE_MAX;
+    finished = false;
+    stopping = false;
+    worker = std::thread(&DecompressionPipeline::run, this);
+    return true;
+}
+
+void DecompressionPipeline::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    buffer_free.notify_all();
+    if (worker.joinable()) worker.join();
+    decoder.reset();
+}
+
+bool DecompressionPipeline::next(Chunk& chunk) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (current != SIZE_MAX) {
+        free_buffers.push_back(current);
+        current = SIZE_MAX;
+        buffer_free.notify_one();
+    }
+
+    if (filled_buffers.empty() && !finished) {
+        auto start = Clock::now();
+        filled_ready.wait(lock, [this] { return !filled_buffers.empty() || finished; });
+        consumer_wait_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+    }
+    if (filled_buffers.empty()) return false;
+
+    Filled filled = filled_buffers.front();
+    filled_buffers.pop_front();
+    current = filled.buffer;
+    chunk.data = buffers[filled.buffer].data();
+    chunk.size = filled.size;
+    return true;
+}
+
+void DecompressionPipeline::run() {
+    // Pipeline hanya dipakai pemuatan CSV terkompresi; CPU dekompresi masuk tahapnya
+    NA_METRIC_STAGE_CPU(STAGE_LOAD_COMPRESSED);
+    for (;;) {
+        size_t index;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if (free_buffers.empty() && !stopping) {
+                auto start = Clock::now();
+                buffer_free.wait(lock, [this] { return !free_buffers.empty() || stopping; });
+                producer_wait_seconds += std::chrono::duration<double>(Clock::now() - start).count();
+            }
+            if (stopping) break;
+            index = free_buffers.front();
+            free_buffers.pop_front();
+        }
+
+        // Dekompresi berjalan tanpa kunci; pemanggil mengurai buffer lain
+        std::vector<char>& buffer = buffers[index];
+        size_t got = decoder->read(buffer.data(), buffer.size(), error);
+        decompressed_bytes += got;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (got > 0) {
+            filled_buffers.push_back({index, got});
+        } else {
+            free_buffers.push_back(index);
+        }
+        if (got < buffer.size() || !error.empty()) break;
+        filled_ready.notify_one();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    finished = true;
+    filled_ready.notify_all();
+}
@@ -0,0 +1,89 @@
+#ifndef DECOMPRESSION_PIPELINE_H
+#define DECOMPRESSION_PIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum Compression {
+    COMPRESSION_NONE,
+    COMPRESSION_GZIP,    // Butuh zlib saat build (NA_HAVE_ZLIB)
+    COMPRESSION_ZSTD     // Butuh libzstd saat build (NA_HAVE_ZSTD)
+};
+
+// Kenali kompresi dari magic number: gzip 1F 8B, zstd 28 B5 2F FD
+Compression detectCompression(const char* begin, const char* end);
+Compression detectFileCompression(const std::string& filename);
+bool isCompressionSupported(Compression compression);
+const char* compressionName(Compression compression);
+
+// Dekompresi file pada thread tersendiri yang menyerahkan potongan hasil ke
+// pemanggil lewat antrean berbatas. Buffer dipakai ulang bergiliran
+// (queue_depth buah), sehingga memori tetap dan dekompresi potongan
+// berikutnya berjalan bersamaan dengan penguraian potongan saat ini.
+// File tanpa kompresi dibaca apa adanya lewat jalur yang sama.
+class DecompressionPipeline {
+public:
+    struct Chunk {
+        const char* data = nullptr;
+        size_t size = 0;
+    };
+
+    explicit DecompressionPipeline(size_t chunk_size = 1 << 20, size_t queue_depth = 4);
+    ~DecompressionPipeline();
+
+    DecompressionPipeline(const DecompressionPipeline&) = delete;
+    DecompressionPipeline& operator=(const DecompressionPipeline&) = delete;
+
+    // Buka file dan mulai thread dekompresi
+    bool open(const std::string& filename);
+    void close();
+
+    // Ambil potongan berikutnya; potongan sebelumnya otomatis dikembalikan ke
+    // thread dekompresi. false di akhir aliran atau jika terjadi galat.
+    bool next(Chunk& chunk);
+
+    const std::string& getError() const { return error; }   // Kosong jika aliran utuh
+    Compression getCompression() const { return compression; }
+    uint64_t getCompressedBytes() const { return compressed_bytes; }
+    uint64_t getDecompressedBytes() const { return decompressed_bytes; }
+    double getConsumerWaitSeconds() const { return consumer_wait_seconds; }   // Pengurai menunggu data
+    double getProducerWaitSeconds() const { return producer_wait_seconds; }   // Dekompresi menunggu buffer
+
+    class Decoder;   // Implementasi per format, lihat decompression_pipeline.cpp
+
+private:
+    struct Filled {
+        size_t buffer;
+        size_t size;
+    };
+
+    std::vector<std::vector<char>> buffers;
+    std::deque<size_t> free_buffers;
+    std::deque<Filled> filled_buffers;
+    std::mutex mutex;
+    std::condition_variable filled_ready;
+    std::condition_variable buffer_free;
+    bool finished;
+    bool stopping;
+    size_t current;               // Buffer yang sedang dipegang pemanggil
+    std::thread worker;
+    std::unique_ptr<Decoder> decoder;
+
+    std::string error;            // Ditulis thread dekompresi sebelum finished
+    Compression compression;
+    uint64_t compressed_bytes;
+    uint64_t decompressed_bytes;
+    double consumer_wait_seconds;
+    double producer_wait_seconds;
+
+    void run();
+};
+
+#endif // DECOMPRESSION_PIPELINE_H
@@ -0,0 +1,305 @@
+#include "flow_tracker.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// Batas jumlah interval untuk rincian per protokol (32 protokol x 8 byte per interval)
+const long long MAX_PROTOCOL_INTERVALS = 1LL << 20;
+
+// Space-Saving melacak lebih banyak kunci daripada yang dilaporkan; galat
+// setiap kunci dibatasi total byte / jumlah penghitung
+const size_t COUNTERS_PER_TOP_K = 8;
+const size_t MIN_COUNTERS = 64;
+
+size_t clampLength(size_t length) {
+    return std::min(length, FlatKeyTable::MAX_KEY_LENGTH);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FlatKeyTable
+// ---------------------------------------------------------------------------
+
+FlatKeyTable::FlatKeyTable(size_t min_capacity) : used(0) {
+    size_t capacity = 2;
+    while (capacity < min_capacity) capacity <<= 1;
+    Slot empty;
+    std::memset(&empty, 0, sizeof(empty));
+    empty.value = -1;
+    slots.assign(capacity, empty);
+    mask = capacity - 1;
+}
+
+uint32_t FlatKeyTable::hashKey(const char* key, size_t length) {
+    // FNV-1a 32-bit atas kunci yang sudah dipotong ke MAX_KEY_LENGTH
+    length = clampLength(length);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(key[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool FlatKeyTable::matches(const Slot& slot, const char* key, size_t length, uint32_t hash) const {
+    return slot.hash == hash && slot.length == length && std::memcmp(slot.key, key, length) == 0;
+}
+
+int32_t FlatKeyTable::find(const char* key, size_t length, uint32_t hash) const {
+    length = clampLength(length);
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        const Slot& slot = slots[i];
+        if (slot.value < 0) return -1;
+        if (matches(slot, key, length, hash)) return slot.value;
+    }
+}
+
+void FlatKeyTable::insert(const char* key, size_t length, uint32_t hash, int32_t value) {
+    length = clampLength(length);
+    size_t i = hash & mask;
+    while (slots[i].value >= 0) i = (i + 1) & mask;
+    Slot& slot = slots[i];
+    slot.hash = hash;
+    slot.value = value;
+    slot.length = static_cast<uint8_t>(length);
+    std::memcpy(slot.key, key, length);
+    used++;
+}
+
+void FlatKeyTable::erase(const char* key, size_t length, uint32_t hash) {
+    length = clampLength(length);
+    size_t i = hash & mask;
+    while (true) {
+        if (slots[i].value < 0) return;
+        if (matches(slots[i], key, length, hash)) break;
+        i = (i + 1) & mask;
+    }
+
+    // Hapus dengan pergeseran mundur agar rantai probing tetap utuh tanpa nisan
+    for (size_t j = (i + 1) & mask; slots[j].value >= 0; j = (j + 1) & mask) {
+        size_t home = slots[j].hash & mask;
+        bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+        if (!stays) {
+            slots[i] = slots[j];
+            i = j;
+        }
+    }
+    slots[i].value = -1;
+    used--;
+}
+
+// ---------------------------------------------------------------------------
+// SpaceSaving
+// ---------------------------------------------------------------------------
+
+SpaceSaving::SpaceSaving(size_t capacity)
+    : capacity(std::max<size_t>(capacity, 1)), index(2 * std::max<size_t>(capacity, 1) + 1) {
+    counters.reserve(this->capacity);
+    heap.reserve(this->capacity);
+    position.reserve(this->capacity);
+}
+
+void SpaceSaving::add(const char* key, size_t length, long long weight) {
+    length = clampLength(length);
+    uint32_t hash = FlatKeyTable::hashKey(key, length);
+
+    int32_t id = index.find(key, length, hash);
+    if (id >= 0) {
+        counters[id].count += weight;
+        siftDown(static_cast<size_t>(position[id]));
+        return;
+    }
+
+    Counter counter;
+    std::memcpy(counter.key, key, length);
+    counter.length = static_cast<uint8_t>(length);
+    counter.hash = hash;
+
+    if (counters.size() < capacity) {
+        id = static_cast<int32_t>(counters.size());
+        counter.count = weight;
+        counter.error = 0;
+        counters.push_back(counter);
+        heap.push_back(id);
+        position.push_back(static_cast<int32_t>(heap.size() - 1));
+        index.insert(key, length, hash, id);
+        siftUp(heap.size() - 1);
+        return;
+    }
+
+    // Ganti penghitung terkecil; hitungan lamanya menjadi batas galat kunci baru
+    id = heap[0];
+    Counter& victim = counters[id];
+    index.erase(victim.key, victim.length, victim.hash);
+    long long minimum = victim.count;
+    counter.count = minimum + weight;
+    counter.error = minimum;
+    victim = counter;
+    index.insert(key, length, hash, id);
+    siftDown(0);
+}
+
+void SpaceSaving::merge(const SpaceSaving& other) {
+    for (const Counter& counter : other.counters) {
+        add(counter.key, counter.length, counter.count);
+        int32_t id = index.find(counter.key, counter.length, counter.hash);
+        if (id >= 0) counters[id].error += counter.error;
+    }
+}
+
+std::vector<HeavyHitter> SpaceSaving::top() const {
+    std::vector<HeavyHitter> result;
+    result.reserve(counters.size());
+    for (const Counter& counter : counters) {
+        result.push_back({std::string(counter.key, counter.length), counter.count, counter.error});
+    }
+    std::sort(result.begin(), result.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+        return a.bytes > b.bytes;
+    });
+    return result;
+}
+
+void SpaceSaving::swapHeap(size_t a, size_t b) {
+    std::swap(heap[a], heap[b]);
+    position[heap[a]] = static_cast<int32_t>(a);
+    position[heap[b]] = static_cast<int32_t>(b);
+}
+
+void SpaceSaving::siftUp(size_t i) {
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (counters[heap[parent]].count <= counters[heap[i]].count) break;
+        swapHeap(i, parent);
+        i = parent;
+    }
+}
+
+void SpaceSaving::siftDown(size_t i) {
+    size_t n = heap.size();
+    while (true) {
+        size_t smallest = i;
+        size_t left = 2 * i + 1;
+        size_t right = left + 1;
+        if (left < n && counters[heap[left]].count < counters[heap[smallest]].count) smallest = left;
+        if (right < n && counters[heap[right]].count < counters[heap[smallest]].count) smallest = right;
+        if (smallest == i) break;
+        swapHeap(i, smallest);
+        i = smallest;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// FlowTracker
+// ---------------------------------------------------------------------------
+
+FlowTracker::FlowTracker(double interval_duration, size_t top_k)
+    : interval_duration(interval_duration), origin(0.0), has_origin(false),
+      protocol_index(2 * MAX_PROTOCOLS), base_interval(0), top_k(std::max<size_t>(top_k, 1)),
+      top_sources(std::max(top_k * COUNTERS_PER_TOP_K, MIN_COUNTERS)),
+      top_destinations(std::max(top_k * COUNTERS_PER_TOP_K, MIN_COUNTERS)) {
+}
+
+void FlowTracker::setOrigin(double origin_time) {
+    origin = origin_time;
+    has_origin = true;
+}
+
+int FlowTracker::internProtocol(const char* protocol, size_t length) {
+    uint32_t hash = FlatKeyTable::hashKey(protocol, length);
+    int32_t id = protocol_index.find(protocol, length, hash);
+    if (id >= 0) return id;
+
+    if (protocol_names.size() + 1 < MAX_PROTOCOLS) {
+        id = static_cast<int32_t>(protocol_names.size());
+        protocol_names.push_back(std::string(protocol, std::min(length, FlatKeyTable::MAX_KEY_LENGTH)));
+        protocol_index.insert(protocol, length, hash, id);
+        return id;
+    }
+
+    // Slot terakhir menampung semua protokol yang tidak muat
+    static const char OTHER[] = "LAINNYA";
+    if (protocol_names.size() + 1 == MAX_PROTOCOLS) protocol_names.push_back(OTHER);
+    return static_cast<int>(MAX_PROTOCOLS) - 1;
+}
+
+void FlowTracker::addPacket(double timestamp, const char* source, size_t source_length,
+                            const char* destination, size_t destination_length,
+                            const char* protocol, size_t protocol_length, long long length) {
+    top_sources.add(source, source_length, length);
+    top_destinations.add(destination, destination_length, length);
+    int protocol_id = internProtocol(protocol, protocol_length);
+
+    if (!has_origin && std::isfinite(timestamp)) setOrigin(timestamp);
+    double position = (timestamp - origin) / interval_duration;
+    if (!(std::fabs(position) < static_cast<double>(MAX_PROTOCOL_INTERVALS))) return;
+    addIntervalBytes(static_cast<long long>(std::floor(position)), protocol_id, length);
+}
+
+void FlowTracker::addIntervalBytes(long long interval_id, int protocol_id, long long bytes) {
+    if (protocol_bytes.empty()) base_interval = interval_id;
+    long long rows = static_cast<long long>(protocol_bytes.size() / MAX_PROTOCOLS);
+    long long offset = interval_id - base_interval;
+
+    if (offset < 0) {
+        if (rows - offset > MAX_PROTOCOL_INTERVALS) return;
+        protocol_bytes.insert(protocol_bytes.begin(), static_cast<size_t>(-offset) * MAX_PROTOCOLS, 0);
+        base_interval = interval_id;
+        offset = 0;
+    } else if (offset >= rows) {
+        if (offset + 1 > MAX_PROTOCOL_INTERVALS) return;
+        protocol_bytes.resize(static_cast<size_t>(offset + 1) * MAX_PROTOCOLS, 0);
+    }
+    protocol_bytes[static_cast<size_t>(offset) * MAX_PROTOCOLS + protocol_id] += bytes;
+}
+
+void FlowTracker::merge(const FlowTracker& other) {
+    // Kedua pelacak harus memakai titik awal dan lebar interval yang sama;
+    // id protokol dipetakan ulang lewat namanya
+    std::vector<int> remap(other.protocol_names.size());
+    for (size_t p = 0; p < other.protocol_names.size(); p++) {
+        const std::string& name = other.protocol_names[p];
+        remap[p] = internProtocol(name.data(), name.size());
+    }
+
+    size_t other_rows = other.protocol_bytes.size() / MAX_PROTOCOLS;
+    for (size_t row = 0; row < other_rows; row++) {
+        const long long* source = &other.protocol_bytes[row * MAX_PROTOCOLS];
+        long long interval_id = other.base_interval + static_cast<long long>(row);
+        for (size_t p = 0; p < other.protocol_names.size(); p++) {
+            if (source[p] != 0) addIntervalBytes(interval_id, remap[p], source[p]);
+        }
+    }
+
+    top_sources.merge(other.top_sources);
+    top_destinations.merge(other.top_destinations);
+}
+
+std::vector<long long> FlowTracker::protocolBytesAt(double interval_start) const {
+    if (!has_origin || protocol_bytes.empty()) return std::vector<long long>();
+    long long interval_id = std::llround((interval_start - origin) / interval_duration);
+    long long offset = interval_id - base_interval;
+    long long rows = static_cast<long long>(protocol_bytes.size() / MAX_PROTOCOLS);
+    if (offset < 0 || offset >= rows) return std::vector<long long>();
+
+    const long long* row = &protocol_bytes[static_cast<size_t>(offset) * MAX_PROTOCOLS];
+    return std::vector<long long>(row, row + protocol_names.size());
+}
+
+std::vector<long long> FlowTracker::protocolTotals() const {
+    std::vector<long long> totals(protocol_names.size(), 0);
+    for (size_t offset = 0; offset < protocol_bytes.size(); offset += MAX_PROTOCOLS) {
+        for (size_t p = 0; p < totals.size(); p++) {
+            totals[p] += protocol_bytes[offset + p];
+        }
+    }
+    return totals;
+}
+
+std::vector<HeavyHitter> FlowTracker::topOf(const SpaceSaving& summary) const {
+    std::vector<HeavyHitter> result = summary.top();
+    if (result.size() > top_k) result.resize(top_k);
+    return result;
+}
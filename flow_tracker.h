@@ -0,0 +1,125 @@
+#ifndef FLOW_TRACKER_H
+#define FLOW_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Tabel hash open-addressing (linear probing) dengan kunci string pendek
+// yang disimpan langsung di slot. Kapasitas tetap, tanpa alokasi per kunci.
+class FlatKeyTable {
+public:
+    static constexpr size_t MAX_KEY_LENGTH = 47;   // Cukup untuk alamat IPv6 tekstual
+
+private:
+    struct Slot {
+        uint32_t hash;
+        int32_t value;                         // -1 = kosong
+        uint8_t length;
+        char key[MAX_KEY_LENGTH];
+    };
+
+    std::vector<Slot> slots;
+    size_t mask;
+    size_t used;
+
+public:
+    explicit FlatKeyTable(size_t min_capacity = 16);
+
+    static uint32_t hashKey(const char* key, size_t length);
+
+    // Kembalikan nilai untuk kunci, atau -1 jika tidak ada
+    int32_t find(const char* key, size_t length, uint32_t hash) const;
+    // Sisipkan kunci baru; pemanggil menjamin tabel belum penuh
+    void insert(const char* key, size_t length, uint32_t hash, int32_t value);
+    void erase(const char* key, size_t length, uint32_t hash);
+
+    size_t size() const { return used; }
+    size_t capacity() const { return slots.size(); }
+
+private:
+    bool matches(const Slot& slot, const char* key, size_t length, uint32_t hash) const;
+};
+
+// Entri heavy hitter: nilai sebenarnya berada di [bytes - error, bytes]
+struct HeavyHitter {
+    std::string key;
+    long long bytes;
+    long long error;
+};
+
+// Algoritma Space-Saving berbobot: melacak k kunci terberat dengan memori O(k)
+class SpaceSaving {
+private:
+    struct Counter {
+        char key[FlatKeyTable::MAX_KEY_LENGTH];
+        uint8_t length;
+        uint32_t hash;
+        long long count;
+        long long error;
+    };
+
+    size_t capacity;
+    std::vector<Counter> counters;   // Id penghitung stabil
+    std::vector<int32_t> heap;       // Min-heap id berdasarkan count
+    std::vector<int32_t> position;   // Posisi id di heap
+    FlatKeyTable index;              // kunci -> id
+
+public:
+    explicit SpaceSaving(size_t capacity = 10);
+
+    void add(const char* key, size_t length, long long weight);
+    void merge(const SpaceSaving& other);
+    std::vector<HeavyHitter> top() const;   // Urut menurun
+    size_t getCapacity() const { return capacity; }
+
+private:
+    void siftUp(size_t i);
+    void siftDown(size_t i);
+    void swapHeap(size_t a, size_t b);
+};
+
+// Agregasi sadar aliran: bandwidth per protokol per interval dan
+// pengirim/penerima teratas. Memori dibatasi oleh jumlah interval dan
+// parameter top_k, bukan jumlah alamat IP yang berbeda.
+class FlowTracker {
+public:
+    static constexpr size_t MAX_PROTOCOLS = 32;    // Protokol ke-32 dan seterusnya digabung ke "LAINNYA"
+
+private:
+    double interval_duration;
+    double origin;
+    bool has_origin;
+    FlatKeyTable protocol_index;
+    std::vector<std::string> protocol_names;
+    long long base_interval;
+    std::vector<long long> protocol_bytes;     // [interval - base][protokol]
+    size_t top_k;
+    SpaceSaving top_sources;                   // Kapasitas beberapa kali top_k agar galat kecil
+    SpaceSaving top_destinations;
+
+public:
+    FlowTracker(double interval_duration, size_t top_k);
+
+    void setOrigin(double origin_time);
+    void addPacket(double timestamp, const char* source, size_t source_length,
+                   const char* destination, size_t destination_length,
+                   const char* protocol, size_t protocol_length, long long length);
+    void merge(const FlowTracker& other);
+
+    const std::vector<std::string>& getProtocolNames() const { return protocol_names; }
+    // Byte per protokol untuk interval yang dimulai pada interval_start (kosong jika tidak ada)
+    std::vector<long long> protocolBytesAt(double interval_start) const;
+    std::vector<long long> protocolTotals() const;   // Jumlah seluruh interval per protokol
+    std::vector<HeavyHitter> getTopSources() const { return topOf(top_sources); }
+    std::vector<HeavyHitter> getTopDestinations() const { return topOf(top_destinations); }
+    size_t getTopK() const { return top_k; }
+
+private:
+    int internProtocol(const char* protocol, size_t length);
+    void addIntervalBytes(long long interval_id, int protocol_id, long long bytes);
+    std::vector<HeavyHitter> topOf(const SpaceSaving& summary) const;
+};
+
+#endif // FLOW_TRACKER_H
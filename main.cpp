@@ -1,7 +1,14 @@
 #include "network_analyzer.h"
+#include "batch_cli.h"
+#include "metrics.h"
+#include "multi_capture.h"
 #include <iostream>
 #include <string>
 
+// Data terproses disimpan dalam format biner; CSV hanya untuk ekspor
+const char* const PROCESSED_BINARY_PATH = "data/processed/network_traffic_timeseries.bin";
+const char* const PROCESSED_CSV_PATH = "data/processed/network_traffic_timeseries.csv";
+
 void printHeader() {
     std::cout << "==========================================" << std::endl;
     std::cout << "  PROGRAM ANALISIS LALU LINTAS JARINGAN" << std::endl;
@@ -19,9 +26,23 @@ void printMenu() {
     std::cout << "4. Tampilkan tabel data per jam" << std::endl;
     std::cout << "5. Jalankan tes interpolasi Lagrange" << std::endl;
     std::cout << "6. Jalankan analisis integrasi Simpson" << std::endl;
-    std::cout << "7. Ekspor hasil ke CSV" << std::endl;
+    std::cout << "7. Ekspor hasil per interval ke CSV" << std::endl;
     std::cout << "8. Mode prediksi interaktif" << std::endl;
     std::cout << "9. Laporan analisis lengkap" << std::endl;
+    std::cout << "10. Muat data mentah mode cepat (mmap)" << std::endl;
+    std::cout << "11. Muat data mentah mode paralel (multi-thread)" << std::endl;
+    std::cout << "12. Ikuti file capture yang terus bertambah (follow)" << std::endl;
+    std::cout << "13. Atur lebar interval agregasi (1-3600 detik)" << std::endl;
+    std::cout << "14. Ekspor data terproses ke CSV" << std::endl;
+    std::cout << "15. Atur derajat interpolasi Lagrange" << std::endl;
+    std::cout << "16. Prediksi pada timestamp Unix (deret penuh)" << std::endl;
+    std::cout << "17. Aktifkan/nonaktifkan mode aliran (protokol & pengirim teratas)" << std::endl;
+    std::cout << "18. Tampilkan laporan aliran" << std::endl;
+    std::cout << "19. Ekspor metrik kinerja (JSON & Prometheus)" << std::endl;
+    std::cout << "20. Analisis banyak capture sekaligus (direktori/glob)" << std::endl;
+    std::cout << "21. Muat capture pcap/pcapng" << std::endl;
+    std::cout << "22. Tampilkan anomali lalu lintas (lonjakan, penurunan, pergeseran level)" << std::endl;
+    std::cout << "23. Agregat rentang waktu Unix (min, maks, rata-rata, volume, paket)" << std::endl;
     std::cout << "0. Keluar" << std::endl;
     std::cout << "Pilihan: ";
 }
@@ -35,18 +56,21 @@ void interactivePrediction(NetworkAnalyzer& analyzer) {
         std::cin >> target_time;
         
         if (target_time >= 0 && target_time <= 24) {
-            double prediction = analyzer.lagrangeInterpolation(target_time);
+            // Prediksi dan kedua titik referensi dievaluasi dalam satu panggilan
+            int hour_before = static_cast<int>(target_time);
+            int hour_after = hour_before + 1;
+            std::vector<double> values = analyzer.lagrangeInterpolation(
+                std::vector<double>{target_time, static_cast<double>(hour_before),
+                                    static_cast<double>(hour_after)});
+            double prediction = values[0];
             std::cout << "Prediksi bandwidth pada " << std::fixed << std::setprecision(2) 
                       << target_time << ":00 = " << std::setprecision(3) 
                       << prediction << " Mbps" << std::endl;
                       
             // Tampilkan nilai aktual terdekat untuk perbandingan
-            int hour_before = static_cast<int>(target_time);
-            int hour_after = hour_before + 1;
-            
             if (hour_after <= 23) {
-                double before = analyzer.lagrangeInterpolation(hour_before);
-                double after = analyzer.lagrangeInterpolation(hour_after);
+                double before = values[1];
+                double after = values[2];
                 std::cout << "  Referensi: " << hour_before << ":00 = " << before 
                           << " Mbps, " << hour_after << ":00 = " << after << " Mbps" << std::endl;
             }
@@ -75,10 +99,10 @@ void runCompleteAnalysis(NetworkAnalyzer& analyzer) {
     std::cout << "Waktu\tPrediksi Bandwidth (Mbps)" << std::endl;
     std::cout << "----\t-------------------------" << std::endl;
     
-    for (double t : test_points) {
-        double pred = analyzer.lagrangeInterpolation(t);
-        std::cout << std::fixed << std::setprecision(1) << t << ":30\t" 
-                  << std::setprecision(3) << pred << std::endl;
+    std::vector<double> predictions = analyzer.lagrangeInterpolation(test_points);
+    for (size_t i = 0; i < test_points.size(); i++) {
+        std::cout << std::fixed << std::setprecision(1) << test_points[i] << ":30\t" 
+                  << std::setprecision(3) << predictions[i] << std::endl;
     }
     
     std::cout << "\n=== ANALISIS INTEGRASI BERDASARKAN PERIODE WAKTU ===" << std::endl;
@@ -97,10 +121,17 @@ void runCompleteAnalysis(NetworkAnalyzer& analyzer) {
         {"Jam Sepi (22-6)", 22, 24}  // Catatan: ini hanya sebagian
     };
     
-    double total_24h = analyzer.simpsonIntegration(0, 24);
-    
+    // Semua rentang dijawab sekaligus dari indeks integral kumulatif
+    std::vector<std::pair<double, double>> ranges = {{0, 24}};
     for (const auto& period : periods) {
-        double consumption = analyzer.simpsonIntegration(period.start, period.end);
+        ranges.push_back({period.start, period.end});
+    }
+    std::vector<double> consumptions = analyzer.simpsonIntegrationBatch(ranges);
+    double total_24h = consumptions[0];
+    
+    for (size_t p = 0; p < periods.size(); p++) {
+        const TimePeriod& period = periods[p];
+        double consumption = consumptions[p + 1];
         double percentage = (consumption / total_24h) * 100;
         double avg_in_period = consumption / (period.end - period.start);
         
@@ -109,6 +140,10 @@ void runCompleteAnalysis(NetworkAnalyzer& analyzer) {
         std::cout << "  Total konsumsi: " << consumption << " Mbps×jam" << std::endl;
         std::cout << "  Persentase harian: " << percentage << "%" << std::endl;
         std::cout << "  Rata-rata dalam periode: " << avg_in_period << " Mbps" << std::endl;
+        if (analyzer.getDataSize() > 0) {
+            std::cout << "  Persentil ke-95 interval: "
+                      << analyzer.getPercentile(95, period.start, period.end) << " Mbps" << std::endl;
+        }
         std::cout << std::endl;
     }
     
@@ -119,9 +154,18 @@ void runCompleteAnalysis(NetworkAnalyzer& analyzer) {
     std::cout << "Bandwidth minimum: " << analyzer.getMinBandwidth() << " Mbps" << std::endl;
     std::cout << "Faktor pemanfaatan puncak: " << std::setprecision(2) 
               << analyzer.getMaxBandwidth() / analyzer.getAverageBandwidth() << std::endl;
+    
+    if (analyzer.getSnapshot()->getFlowTracker()) {
+        analyzer.printFlowReport(5);
+    }
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Dengan argumen: mode batch non-interaktif (lihat batch_cli.h)
+    if (argc > 1) {
+        return runBatchCommand(argc, argv, PROCESSED_BINARY_PATH);
+    }
+    
     printHeader();
     
     NetworkAnalyzer analyzer;
@@ -137,7 +181,7 @@ int main() {
                 std::cout << "\nMemuat data mentah dari data/raw/output1.csv..." << std::endl;
                 if (analyzer.loadRawData("data/raw/output1.csv")) {
                     std::cout << "Data mentah berhasil dimuat dan diproses!" << std::endl;
-                    analyzer.saveProcessedData("data/processed/network_traffic_timeseries.csv");
+                    analyzer.saveProcessedBinary(PROCESSED_BINARY_PATH);
                     dataLoaded = true;
                 } else {
                     std::cout << "Gagal memuat data mentah. Periksa lokasi file." << std::endl;
@@ -147,7 +191,7 @@ int main() {
             
             case 2: {
                 std::cout << "\nMemuat data yang sudah diproses..." << std::endl;
-                if (analyzer.loadProcessedData("data/processed/network_traffic_timeseries.csv")) {
+                if (analyzer.loadProcessedBinary(PROCESSED_BINARY_PATH)) {
                     std::cout << "Data terproses berhasil dimuat!" << std::endl;
                     dataLoaded = true;
                 } else {
@@ -182,10 +226,10 @@ int main() {
                 std::cout << "\n=== TES INTERPOLASI LAGRANGE ===" << std::endl;
                 std::vector<double> test_times = {8.5, 12.5, 15.5, 20.5};
                 
-                for (double t : test_times) {
-                    double predicted = analyzer.lagrangeInterpolation(t);
-                    std::cout << "Bandwidth pada " << t << ":30 = " 
-                              << std::fixed << std::setprecision(3) << predicted << " Mbps" << std::endl;
+                std::vector<double> predicted = analyzer.lagrangeInterpolation(test_times);
+                for (size_t i = 0; i < test_times.size(); i++) {
+                    std::cout << "Bandwidth pada " << test_times[i] << ":30 = " 
+                              << std::fixed << std::setprecision(3) << predicted[i] << " Mbps" << std::endl;
                 }
                 break;
             }
@@ -200,6 +244,21 @@ int main() {
                 std::cout << "Total konsumsi bandwidth (24 jam): " 
                           << std::fixed << std::setprecision(3) << total << " Mbps×jam" << std::endl;
                 std::cout << "Rata-rata bandwidth: " << total/24.0 << " Mbps" << std::endl;
+                
+                // Pembanding: Simpson adaptif atas kurva interpolasi dengan perkiraan galat
+                IntegrationResult adaptive = analyzer.integrateAdaptive(0.0, 23.0, 1e-6);
+                std::cout << "Simpson adaptif atas interpolan: " << adaptive.value << " Mbps×jam (galat ~"
+                          << std::scientific << std::setprecision(1) << adaptive.error_estimate
+                          << std::fixed << std::setprecision(3) << ", " << adaptive.evaluations
+                          << " evaluasi)" << std::endl;
+                if (analyzer.getDataSize() > 1) {
+                    std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+                    const TimeSeriesStore& series = snapshot->getSeries();
+                    IntegrationResult series_total = analyzer.integrateSeriesAdaptive(
+                        series.firstTimestamp(), series.lastTimestamp(), 1e-6);
+                    std::cout << "Konsumsi deret penuh (adaptif): " << series_total.value
+                              << " Mbps×jam (" << series_total.evaluations << " evaluasi)" << std::endl;
+                }
                 break;
             }
             
@@ -230,6 +289,187 @@ int main() {
                 break;
             }
             
+            case 10: {
+                std::cout << "\nMemuat data mentah (mmap) dari data/raw/output1.csv..." << std::endl;
+                if (analyzer.loadRawDataMapped("data/raw/output1.csv")) {
+                    std::cout << "Data mentah berhasil dimuat dan diproses!" << std::endl;
+                    analyzer.saveProcessedBinary(PROCESSED_BINARY_PATH);
+                    dataLoaded = true;
+                } else {
+                    std::cout << "Gagal memuat data mentah. Periksa lokasi file." << std::endl;
+                }
+                break;
+            }
+            
+            case 11: {
+                unsigned num_threads;
+                std::cout << "Jumlah thread (0 = otomatis): ";
+                std::cin >> num_threads;
+                std::cout << "\nMemuat data mentah (paralel) dari data/raw/output1.csv..." << std::endl;
+                if (analyzer.loadRawDataParallel("data/raw/output1.csv", num_threads)) {
+                    std::cout << "Data mentah berhasil dimuat dan diproses!" << std::endl;
+                    analyzer.saveProcessedBinary(PROCESSED_BINARY_PATH);
+                    dataLoaded = true;
+                } else {
+                    std::cout << "Gagal memuat data mentah. Periksa lokasi file." << std::endl;
+                }
+                break;
+            }
+            
+            case 12: {
+                double idle_timeout;
+                std::cout << "Berhenti setelah berapa detik tanpa data baru? ";
+                std::cin >> idle_timeout;
+                if (analyzer.followRawData("data/raw/output1.csv", 1000, idle_timeout)) {
+                    analyzer.saveProcessedBinary(PROCESSED_BINARY_PATH);
+                    dataLoaded = true;
+                } else {
+                    std::cout << "Gagal mengikuti data mentah. Periksa lokasi file." << std::endl;
+                }
+                break;
+            }
+            
+            case 13: {
+                double seconds;
+                std::cout << "Lebar interval saat ini: " << analyzer.getIntervalDuration()
+                          << " detik. Lebar baru: ";
+                std::cin >> seconds;
+                if (analyzer.setIntervalDuration(seconds)) {
+                    std::cout << "Lebar interval diatur. Muat ulang data mentah untuk menerapkan." << std::endl;
+                }
+                break;
+            }
+            
+            case 14: {
+                if (!dataLoaded) {
+                    std::cout << "Silakan muat data terlebih dahulu (pilihan 1 atau 2)." << std::endl;
+                    break;
+                }
+                analyzer.saveProcessedData(PROCESSED_CSV_PATH);
+                break;
+            }
+            
+            case 15: {
+                int degree;
+                std::cout << "Derajat saat ini: " << analyzer.getLagrangeDegree()
+                          << ". Derajat baru (-1 = polinom global melalui semua titik): ";
+                std::cin >> degree;
+                analyzer.setLagrangeDegree(degree);
+                std::cout << "Derajat interpolasi Lagrange diatur ke " << degree << "." << std::endl;
+                break;
+            }
+            
+            case 16: {
+                if (!dataLoaded || analyzer.getDataSize() == 0) {
+                    std::cout << "Silakan muat data mentah atau biner terlebih dahulu." << std::endl;
+                    break;
+                }
+                std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+                const TimeSeriesStore& series = snapshot->getSeries();
+                double unix_time;
+                std::cout << std::fixed << std::setprecision(0)
+                          << "Rentang deret: " << series.firstTimestamp() << " - "
+                          << series.lastTimestamp() << ". Timestamp Unix: ";
+                std::cin >> unix_time;
+                std::cout << "Prediksi bandwidth pada " << unix_time << " = " << std::setprecision(3)
+                          << analyzer.interpolateAt(unix_time) << " Mbps (derajat "
+                          << analyzer.getSeriesInterpolationDegree() << ")" << std::endl;
+                break;
+            }
+            
+            case 17: {
+                if (analyzer.isFlowTracking()) {
+                    analyzer.setFlowTracking(false);
+                    std::cout << "Mode aliran dinonaktifkan." << std::endl;
+                    break;
+                }
+                size_t top_k;
+                std::cout << "Jumlah pengirim/penerima teratas yang dilacak: ";
+                std::cin >> top_k;
+                analyzer.setFlowTracking(true, top_k);
+                std::cout << "Mode aliran diaktifkan. Muat ulang data mentah untuk menerapkan." << std::endl;
+                break;
+            }
+            
+            case 18: {
+                analyzer.printFlowReport();
+                break;
+            }
+            
+            case 19: {
+                if (!metrics::enabled()) {
+                    std::cout << "Metrik tidak aktif pada build ini (kompilasi dengan NA_METRICS)." << std::endl;
+                }
+                if (metrics::writeJson("data/results/metrics.json") &&
+                    metrics::writePrometheus("data/results/metrics.prom")) {
+                    std::cout << "Metrik diekspor ke data/results/metrics.json dan metrics.prom" << std::endl;
+                }
+                break;
+            }
+            
+            case 20: {
+                std::string pattern;
+                unsigned threads;
+                std::cout << "Direktori atau pola glob (mis. data/raw/*.csv): ";
+                std::cin >> pattern;
+                std::cout << "Jumlah thread (0 = semua core): ";
+                std::cin >> threads;
+                MultiCaptureReport report;
+                if (analyzeCaptures(listCaptures(pattern), report,
+                                    analyzer.getIntervalDuration(), threads)) {
+                    printMultiCaptureReport(report);
+                }
+                break;
+            }
+            
+            case 21: {
+                std::string path;
+                std::cout << "Path file pcap/pcapng: ";
+                std::cin >> path;
+                if (analyzer.loadPcap(path)) {
+                    std::cout << "Capture berhasil dimuat dan diproses!" << std::endl;
+                    analyzer.saveProcessedBinary(PROCESSED_BINARY_PATH);
+                    dataLoaded = true;
+                } else {
+                    std::cout << "Gagal memuat capture. Periksa lokasi dan format file." << std::endl;
+                }
+                break;
+            }
+            
+            case 22: {
+                if (!dataLoaded) {
+                    std::cout << "Silakan muat data terlebih dahulu (pilihan 1 atau 2)." << std::endl;
+                    break;
+                }
+                analyzer.printAnomalyReport();
+                break;
+            }
+            
+            case 23: {
+                if (analyzer.getDataSize() == 0) {
+                    std::cout << "Silakan muat data mentah atau biner terlebih dahulu." << std::endl;
+                    break;
+                }
+                std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+                const TimeSeriesStore& series = snapshot->getSeries();
+                double start_unix, end_unix;
+                std::cout << std::fixed << std::setprecision(0)
+                          << "Rentang deret: " << series.firstTimestamp() << " - "
+                          << series.lastTimestamp() << ". Timestamp awal dan akhir: ";
+                std::cin >> start_unix >> end_unix;
+                RangeAggregate window = analyzer.aggregateRange(start_unix, end_unix);
+                if (window.count == 0) {
+                    std::cout << "Tidak ada interval dalam rentang tersebut." << std::endl;
+                    break;
+                }
+                std::cout << std::setprecision(3) << window.count << " interval, min " << window.min
+                          << " Mbps, maks " << window.max << " Mbps, rata-rata " << window.mean()
+                          << " Mbps" << std::endl;
+                std::cout << "Volume: " << window.volume(analyzer.getIntervalDuration())
+                          << " Mbps×jam, paket: " << window.packets << std::endl;
+                break;
+            }
+            
             case 0: {
                 std::cout << "\nTerima kasih telah menggunakan Program Analisis Lalu Lintas Jaringan!" << std::endl;
                 std::cout << "Analisis selesai." << std::endl;
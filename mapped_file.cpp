@@ -0,0 +1,117 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : mapped_data(nullptr), mapped_size(0), opened(false)
+#ifdef _WIN32
+    , file_handle(nullptr), mapping_handle(nullptr)
+#else
+    , file_descriptor(-1)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle = file;
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    opened = true;
+
+    // File kosong tidak dapat dipetakan, tetapi tetap dianggap terbuka
+    if (mapped_size == 0) return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        return false;
+    }
+    mapping_handle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr) {
+        close();
+        return false;
+    }
+    mapped_data = static_cast<const char*>(view);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) UnmapViewOfFile(mapped_data);
+    if (mapping_handle != nullptr) CloseHandle(static_cast<HANDLE>(mapping_handle));
+    if (file_handle != nullptr) CloseHandle(static_cast<HANDLE>(file_handle));
+    mapped_data = nullptr;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+    mapped_size = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    file_descriptor = fd;
+    mapped_size = static_cast<size_t>(st.st_size);
+    opened = true;
+
+    // File kosong tidak dapat dipetakan, tetapi tetap dianggap terbuka
+    if (mapped_size == 0) return true;
+
+    void* addr = mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr == MAP_FAILED) {
+        close();
+        return false;
+    }
+
+    // Pembacaan berurutan: minta kernel melakukan read-ahead agresif
+    madvise(addr, mapped_size, MADV_SEQUENTIAL);
+    mapped_data = static_cast<const char*>(addr);
+    return true;
+}
+
+void MappedFile::close() {
+    if (mapped_data != nullptr) munmap(const_cast<char*>(mapped_data), mapped_size);
+    if (file_descriptor >= 0) ::close(file_descriptor);
+    mapped_data = nullptr;
+    file_descriptor = -1;
+    mapped_size = 0;
+    opened = false;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// Pemetaan file read-only ke memori (mmap) sehingga isi file dapat
+// dipindai langsung tanpa disalin ke buffer std::string.
+class MappedFile {
+private:
+    const char* mapped_data;
+    size_t mapped_size;
+    bool opened;
+#ifdef _WIN32
+    void* file_handle;
+    void* mapping_handle;
+#else
+    int file_descriptor;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const char* begin() const { return mapped_data; }
+    const char* end() const { return mapped_data + mapped_size; }
+    size_t size() const { return mapped_size; }
+};
+
+#endif // MAPPED_FILE_H
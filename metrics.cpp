@@ -0,0 +1,186 @@
+#include "metrics.h"
+#include <atomic>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <time.h>
+
+namespace metrics {
+
+namespace {
+
+struct CounterInfo {
+    const char* name;
+    const char* help;
+};
+
+const CounterInfo COUNTERS[COUNTER_COUNT] = {
+    {"rows_parsed", "Baris paket valid yang diurai dari data mentah"},
+    {"rows_skipped", "Baris data mentah yang dilewati karena tidak valid"},
+    {"bytes_read", "Byte data mentah atau biner yang dibaca"},
+    {"bytes_decompressed", "Byte CSV hasil dekompresi data mentah terkompresi"},
+    {"bytes_written", "Byte file biner dan hasil ekspor yang ditulis"},
+    {"intervals_produced", "Interval waktu yang dihasilkan dari paket mentah"},
+    {"interpolation_queries", "Titik yang dievaluasi oleh interpolasi"},
+    {"integration_queries", "Rentang yang diintegrasikan"},
+    {"percentile_queries", "Kueri persentil"},
+    {"range_queries", "Kueri agregat rentang waktu"},
+};
+
+const char* const STAGES[STAGE_COUNT] = {
+    "load_getline",
+    "load_mmap",
+    "load_parallel",
+    "load_pcap",
+    "load_compressed",
+    "follow",
+    "aggregate",
+    "hourly_pattern",
+    "load_binary",
+    "save_binary",
+    "statistics",
+    "interpolation",
+    "integration",
+    "export",
+};
+
+struct StageTotals {
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> wall_ns{0};
+    std::atomic<uint64_t> cpu_ns{0};
+    std::atomic<uint64_t> max_wall_ns{0};
+};
+
+// Atomik relaxed: hanya jumlah akhir yang penting, bukan urutan antar thread
+std::atomic<uint64_t> counters[COUNTER_COUNT];
+StageTotals stages[STAGE_COUNT];
+
+std::string formatSeconds(uint64_t ns) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9f", ns / 1e9);
+    return text;
+}
+
+bool writeText(const std::string& filename, const std::string& text) {
+    std::ofstream out(filename, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Tidak dapat menulis file metrik " << filename << std::endl;
+        return false;
+    }
+    out << text;
+    return static_cast<bool>(out);
+}
+
+} // namespace
+
+void add(Counter counter, uint64_t value) {
+    counters[counter].fetch_add(value, std::memory_order_relaxed);
+}
+
+void record(Stage stage, uint64_t wall_ns, uint64_t cpu_ns) {
+    StageTotals& totals = stages[stage];
+    totals.calls.fetch_add(1, std::memory_order_relaxed);
+    totals.wall_ns.fetch_add(wall_ns, std::memory_order_relaxed);
+    totals.cpu_ns.fetch_add(cpu_ns, std::memory_order_relaxed);
+    uint64_t previous = totals.max_wall_ns.load(std::memory_order_relaxed);
+    while (wall_ns > previous &&
+           !totals.max_wall_ns.compare_exchange_weak(previous, wall_ns, std::memory_order_relaxed)) {
+    }
+}
+
+void recordCpu(Stage stage, uint64_t cpu_ns) {
+    stages[stage].cpu_ns.fetch_add(cpu_ns, std::memory_order_relaxed);
+}
+
+uint64_t threadCpuNanoseconds() {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec now;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) == 0) {
+        return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    }
+#endif
+    return static_cast<uint64_t>(std::clock() * (1e9 / CLOCKS_PER_SEC));
+}
+
+void reset() {
+    for (auto& counter : counters) counter.store(0, std::memory_order_relaxed);
+    for (auto& totals : stages) {
+        totals.calls.store(0, std::memory_order_relaxed);
+        totals.wall_ns.store(0, std::memory_order_relaxed);
+        totals.cpu_ns.store(0, std::memory_order_relaxed);
+        totals.max_wall_ns.store(0, std::memory_order_relaxed);
+    }
+}
+
+std::string toJson() {
+    std::string json = "{\n  \"enabled\": ";
+    json += enabled() ? "true" : "false";
+    json += ",\n  \"counters\": {";
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        json += c == 0 ? "\n    \"" : ",\n    \"";
+        json += COUNTERS[c].name;
+        json += "\": " + std::to_string(counters[c].load(std::memory_order_relaxed));
+    }
+    json += "\n  },\n  \"stages\": {";
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        const StageTotals& totals = stages[s];
+        json += s == 0 ? "\n    \"" : ",\n    \"";
+        json += STAGES[s];
+        json += "\": {\"calls\": " + std::to_string(totals.calls.load(std::memory_order_relaxed));
+        json += ", \"wall_seconds\": " + formatSeconds(totals.wall_ns.load(std::memory_order_relaxed));
+        json += ", \"cpu_seconds\": " + formatSeconds(totals.cpu_ns.load(std::memory_order_relaxed));
+        json += ", \"max_wall_seconds\": " +
+                formatSeconds(totals.max_wall_ns.load(std::memory_order_relaxed)) + "}";
+    }
+    json += "\n  }\n}\n";
+    return json;
+}
+
+std::string toPrometheus() {
+    std::string text;
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        std::string name = std::string("network_analyzer_") + COUNTERS[c].name + "_total";
+        text += "# HELP " + name + " " + COUNTERS[c].help + "\n";
+        text += "# TYPE " + name + " counter\n";
+        text += name + " " + std::to_string(counters[c].load(std::memory_order_relaxed)) + "\n";
+    }
+
+    struct StageMetric {
+        const char* name;
+        const char* help;
+        const char* type;
+    };
+    const StageMetric STAGE_METRICS[] = {
+        {"network_analyzer_stage_calls_total", "Jumlah eksekusi tahap", "counter"},
+        {"network_analyzer_stage_wall_seconds_total", "Waktu dinding kumulatif per tahap", "counter"},
+        {"network_analyzer_stage_cpu_seconds_total", "Waktu CPU thread kumulatif per tahap, termasuk thread pembantunya", "counter"},
+        {"network_analyzer_stage_max_wall_seconds", "Waktu dinding terlama satu eksekusi tahap", "gauge"},
+    };
+    for (int m = 0; m < 4; m++) {
+        text += std::string("# HELP ") + STAGE_METRICS[m].name + " " + STAGE_METRICS[m].help + "\n";
+        text += std::string("# TYPE ") + STAGE_METRICS[m].name + " " + STAGE_METRICS[m].type + "\n";
+        for (int s = 0; s < STAGE_COUNT; s++) {
+            const StageTotals& totals = stages[s];
+            std::string value;
+            switch (m) {
+                case 0: value = std::to_string(totals.calls.load(std::memory_order_relaxed)); break;
+                case 1: value = formatSeconds(totals.wall_ns.load(std::memory_order_relaxed)); break;
+                case 2: value = formatSeconds(totals.cpu_ns.load(std::memory_order_relaxed)); break;
+                default: value = formatSeconds(totals.max_wall_ns.load(std::memory_order_relaxed)); break;
+            }
+            text += std::string(STAGE_METRICS[m].name) + "{stage=\"" + STAGES[s] + "\"} " + value + "\n";
+        }
+    }
+    return text;
+}
+
+bool writeJson(const std::string& filename) {
+    return writeText(filename, toJson());
+}
+
+bool writePrometheus(const std::string& filename) {
+    return writeText(filename, toPrometheus());
+}
+
+} // namespace metrics
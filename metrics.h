@@ -0,0 +1,132 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Instrumentasi ringan: penghitung global dan pengukur waktu per tahap.
+//
+// Aktif hanya jika NA_METRICS didefinisikan (opsi CMake NA_ENABLE_METRICS).
+// Tanpa NA_METRICS semua makro NA_METRIC_* menjadi pernyataan kosong sehingga
+// jalur panas tidak membayar apa pun; fungsi ekspor tetap tersedia dan
+// melaporkan "enabled": false.
+namespace metrics {
+
+enum Counter {
+    ROWS_PARSED,
+    ROWS_SKIPPED,
+    BYTES_READ,
+    BYTES_DECOMPRESSED,
+    BYTES_WRITTEN,
+    INTERVALS_PRODUCED,
+    INTERPOLATION_QUERIES,
+    INTEGRATION_QUERIES,
+    PERCENTILE_QUERIES,
+    RANGE_QUERIES,
+    COUNTER_COUNT
+};
+
+enum Stage {
+    STAGE_LOAD_GETLINE,
+    STAGE_LOAD_MMAP,
+    STAGE_LOAD_PARALLEL,
+    STAGE_LOAD_PCAP,
+    STAGE_LOAD_COMPRESSED,
+    STAGE_FOLLOW,
+    STAGE_AGGREGATE,
+    STAGE_HOURLY_PATTERN,
+    STAGE_LOAD_BINARY,
+    STAGE_SAVE_BINARY,
+    STAGE_STATISTICS,
+    STAGE_INTERPOLATION,
+    STAGE_INTEGRATION,
+    STAGE_EXPORT,
+    STAGE_COUNT
+};
+
+constexpr bool enabled() {
+#ifdef NA_METRICS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void add(Counter counter, uint64_t value);
+void record(Stage stage, uint64_t wall_ns, uint64_t cpu_ns);
+void recordCpu(Stage stage, uint64_t cpu_ns);   // Tanpa menambah panggilan maupun waktu dinding
+void reset();
+
+// Waktu CPU thread pemanggil (CLOCK_THREAD_CPUTIME_ID). Pada platform tanpa
+// jam CPU per thread jatuh ke std::clock, yaitu CPU seluruh proses.
+uint64_t threadCpuNanoseconds();
+
+std::string toJson();
+std::string toPrometheus();
+bool writeJson(const std::string& filename);
+bool writePrometheus(const std::string& filename);
+
+// Mengukur waktu dinding (dan waktu CPU thread ini jika with_cpu) sampai
+// akhir scope. Tahap yang berjalan bersamaan di thread berbeda masing-masing
+// hanya dibebani CPU-nya sendiri; kueri numerik hanya mengukur waktu dinding.
+class ScopedTimer {
+private:
+    Stage stage;
+    bool with_cpu;
+    std::chrono::steady_clock::time_point wall_start;
+    uint64_t cpu_start;
+
+public:
+    ScopedTimer(Stage stage, bool with_cpu)
+        : stage(stage), with_cpu(with_cpu), wall_start(std::chrono::steady_clock::now()),
+          cpu_start(with_cpu ? threadCpuNanoseconds() : 0) {}
+
+    ~ScopedTimer() {
+        auto wall = std::chrono::steady_clock::now() - wall_start;
+        uint64_t cpu_ns = with_cpu ? threadCpuNanoseconds() - cpu_start : 0;
+        record(stage, static_cast<uint64_t>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count()), cpu_ns);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// CPU thread pembantu (pekerja ingest paralel, thread dekompresi) yang
+// ditambahkan ke tahap pemanggilnya tanpa dihitung sebagai panggilan baru
+class ScopedCpuTimer {
+private:
+    Stage stage;
+    uint64_t cpu_start;
+
+public:
+    explicit ScopedCpuTimer(Stage stage) : stage(stage), cpu_start(threadCpuNanoseconds()) {}
+    ~ScopedCpuTimer() { recordCpu(stage, threadCpuNanoseconds() - cpu_start); }
+
+    ScopedCpuTimer(const ScopedCpuTimer&) = delete;
+    ScopedCpuTimer& operator=(const ScopedCpuTimer&) = delete;
+};
+
+} // namespace metrics
+
+#define NA_METRIC_CONCAT_INNER(a, b) a##b
+#define NA_METRIC_CONCAT(a, b) NA_METRIC_CONCAT_INNER(a, b)
+
+#ifdef NA_METRICS
+#define NA_METRIC_COUNT(counter, value) \
+    ::metrics::add(::metrics::counter, static_cast<uint64_t>(value))
+#define NA_METRIC_STAGE(stage) \
+    ::metrics::ScopedTimer NA_METRIC_CONCAT(na_metric_timer_, __LINE__)(::metrics::stage, true)
+#define NA_METRIC_QUERY(stage) \
+    ::metrics::ScopedTimer NA_METRIC_CONCAT(na_metric_timer_, __LINE__)(::metrics::stage, false)
+#define NA_METRIC_STAGE_CPU(stage) \
+    ::metrics::ScopedCpuTimer NA_METRIC_CONCAT(na_metric_timer_, __LINE__)(::metrics::stage)
+#else
+#define NA_METRIC_COUNT(counter, value) ((void)0)
+#define NA_METRIC_STAGE(stage) ((void)0)
+#define NA_METRIC_QUERY(stage) ((void)0)
+#define NA_METRIC_STAGE_CPU(stage) ((void)0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,213 @@
+#include "multi_capture.h"
+#include "network_analyzer.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Pencocokan wildcard sederhana: '*' = nol atau lebih karakter, '?' = satu
+// karakter. Backtracking hanya ke '*' terakhir sehingga tetap linear.
+bool matchWildcard(const std::string& text, const std::string& pattern) {
+    size_t t = 0, p = 0;
+    size_t star = std::string::npos, resume = 0;
+    while (t < text.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+            t++;
+            p++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            star = p++;
+            resume = t;
+        } else if (star != std::string::npos) {
+            p = star + 1;
+            t = ++resume;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') p++;
+    return p == pattern.size();
+}
+
+void analyzeOne(const std::string& path, double interval_seconds,
+                CaptureSummary& summary, QuantileSketch& sketch) {
+    auto start = std::chrono::steady_clock::now();
+    summary.path = path;
+
+    NetworkAnalyzer analyzer;
+    analyzer.setQuiet(true);
+    if (!analyzer.setIntervalDuration(interval_seconds) || !analyzer.loadCapture(path)) {
+        summary.ok = false;
+        return;
+    }
+    if (analyzer.getDataSize() == 0) {
+        std::cerr << "Error: Tidak ada paket valid dalam " << path << std::endl;
+        summary.ok = false;
+        return;
+    }
+
+    std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+    const TimeSeriesStore& series = snapshot->getSeries();
+    summary.ok = true;
+    summary.intervals = series.size();
+    const int64_t* packets = series.packets();
+    for (size_t i = 0; i < series.size(); i++) summary.packets += packets[i];
+    summary.start_time = series.firstTimestamp();
+    summary.end_time = series.lastTimestamp();
+    summary.stats = analyzer.getSeriesStatistics();
+    summary.p50 = analyzer.getPercentile(50);
+    summary.p95 = analyzer.getPercentile(95);
+    summary.p99 = analyzer.getPercentile(99);
+
+    // Setiap interval adalah rata-rata bandwidth selama lebar interval, sehingga
+    // volume tepatnya jumlah bandwidth × lebar, sama dengan integral kumulatif
+    // export-series dan RangeAggregate::volume. Interval terakhir ikut dihitung
+    // penuh dan celah tanpa paket bernilai nol, tidak dijembatani interpolan.
+    const double* bandwidth = series.bandwidth();
+    double interval_hours = analyzer.getIntervalDuration() / 3600.0;
+    for (size_t i = 0; i < series.size(); i++) summary.consumption += bandwidth[i] * interval_hours;
+    sketch = analyzer.getSnapshot()->getSeriesSketch();
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    summary.seconds = elapsed.count();
+}
+
+} // namespace
+
+std::vector<std::string> listCaptures(const std::string& pattern) {
+    std::vector<std::string> files;
+    std::error_code ec;
+    fs::path target(pattern);
+
+    if (fs::is_regular_file(target, ec)) {
+        files.push_back(target.string());
+        return files;
+    }
+
+    fs::path directory;
+    std::vector<std::string> name_patterns;
+    if (fs::is_directory(target, ec)) {
+        directory = target;
+        name_patterns = {"*.csv", "*.csv.gz", "*.csv.zst", "*.pcap", "*.pcapng", "*.cap"};
+    } else {
+        directory = target.has_parent_path() ? target.parent_path() : fs::path(".");
+        name_patterns.push_back(target.filename().string());
+        if (name_patterns[0].find_first_of("*?") == std::string::npos) {
+            std::cerr << "Error: " << pattern << " bukan file, direktori, atau pola glob" << std::endl;
+            return files;
+        }
+    }
+
+    fs::directory_iterator it(directory, ec);
+    if (ec) {
+        std::cerr << "Error: Tidak dapat membaca direktori " << directory.string() << std::endl;
+        return files;
+    }
+    for (const fs::directory_entry& entry : it) {
+        if (!entry.is_regular_file(ec)) continue;
+        std::string name = entry.path().filename().string();
+        for (const std::string& name_pattern : name_patterns) {
+            if (matchWildcard(name, name_pattern)) {
+                files.push_back(entry.path().string());
+                break;
+            }
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+bool analyzeCaptures(const std::vector<std::string>& files, MultiCaptureReport& report,
+                     double interval_seconds, unsigned num_threads) {
+    report = MultiCaptureReport();
+    if (files.empty()) {
+        std::cerr << "Error: Tidak ada file capture untuk dianalisis" << std::endl;
+        return false;
+    }
+
+    if (num_threads == 0) num_threads = std::max(1u, std::thread::hardware_concurrency());
+    num_threads = static_cast<unsigned>(std::min<size_t>(num_threads, files.size()));
+    report.threads = num_threads;
+    report.captures.resize(files.size());
+    std::vector<QuantileSketch> sketches(files.size());
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        // File besar dikirim lebih dulu agar tidak tertinggal di ekor antrean
+        std::vector<size_t> order(files.size());
+        std::vector<uintmax_t> sizes(files.size(), 0);
+        for (size_t i = 0; i < files.size(); i++) {
+            order[i] = i;
+            std::error_code ec;
+            uintmax_t size = fs::file_size(files[i], ec);
+            sizes[i] = ec ? 0 : size;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&sizes](size_t a, size_t b) { return sizes[a] > sizes[b]; });
+
+        ThreadPool pool(num_threads);
+        for (size_t i : order) {
+            pool.submit([&, i] {
+                analyzeOne(files[i], interval_seconds, report.captures[i], sketches[i]);
+            });
+        }
+        pool.wait();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    report.wall_seconds = elapsed.count();
+
+    // Penggabungan berurutan menurut daftar file sehingga hasil deterministik
+    for (size_t i = 0; i < files.size(); i++) {
+        const CaptureSummary& summary = report.captures[i];
+        report.file_seconds += summary.seconds;
+        if (!summary.ok) {
+            report.failed++;
+            continue;
+        }
+        report.packets += summary.packets;
+        report.stats = mergeTrafficStatistics(report.stats, summary.stats);
+        report.sketch.merge(sketches[i]);
+        report.consumption += summary.consumption;
+    }
+    report.p50 = report.sketch.quantile(0.50);
+    report.p95 = report.sketch.quantile(0.95);
+    report.p99 = report.sketch.quantile(0.99);
+    return report.failed < files.size();
+}
+
+void printMultiCaptureReport(const MultiCaptureReport& report) {
+    std::cout << "\n=== ANALISIS BANYAK CAPTURE ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    for (const CaptureSummary& summary : report.captures) {
+        std::cout << fs::path(summary.path).filename().string() << ": ";
+        if (!summary.ok) {
+            std::cout << "GAGAL" << std::endl;
+            continue;
+        }
+        std::cout << summary.intervals << " interval, rata-rata " << summary.stats.mean
+                  << " Mbps, p95 " << summary.p95 << " Mbps, konsumsi " << summary.consumption
+                  << " Mbps×jam (" << summary.seconds << " s)" << std::endl;
+    }
+
+    size_t analyzed = report.captures.size() - report.failed;
+    std::cout << "\n=== LAPORAN GABUNGAN ===" << std::endl;
+    std::cout << "File dianalisis: " << analyzed << " dari " << report.captures.size() << std::endl;
+    std::cout << "Total paket: " << report.packets << std::endl;
+    std::cout << "Total interval: " << report.stats.count << std::endl;
+    std::cout << "Rata-rata bandwidth: " << report.stats.mean << " Mbps" << std::endl;
+    std::cout << "Bandwidth puncak: " << report.stats.max << " Mbps" << std::endl;
+    std::cout << "Bandwidth minimum: " << report.stats.min << " Mbps" << std::endl;
+    std::cout << "Simpangan baku: " << report.stats.stddev << " Mbps" << std::endl;
+    std::cout << "p50/p95/p99: " << report.p50 << " / " << report.p95 << " / " << report.p99
+              << " Mbps (galat relatif maksimum "
+              << report.sketch.getRelativeAccuracy() * 100 << "%)" << std::endl;
+    std::cout << "Total konsumsi: " << report.consumption << " Mbps×jam" << std::endl;
+    std::cout << "Waktu: " << report.wall_seconds << " s dinding, " << report.file_seconds
+              << " s total per file, " << report.threads << " thread" << std::endl;
+}
@@ -0,0 +1,53 @@
+#ifndef MULTI_CAPTURE_H
+#define MULTI_CAPTURE_H
+
+#include <string>
+#include <vector>
+#include "quantile_sketch.h"
+#include "traffic_statistics.h"
+
+// Ringkasan satu file capture yang dianalisis oleh analyzer tersendiri
+struct CaptureSummary {
+    std::string path;
+    bool ok = false;
+    size_t intervals = 0;
+    long long packets = 0;
+    double start_time = 0.0;       // Timestamp Unix interval pertama
+    double end_time = 0.0;         // Timestamp Unix interval terakhir
+    TrafficStatistics stats;       // Atas seluruh deret interval
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double consumption = 0.0;      // Volume: jumlah bandwidth × lebar interval (Mbps×jam)
+    double seconds = 0.0;          // Waktu analisis file ini
+};
+
+// Laporan gabungan: statistik digabung secara eksak, persentil dari sketsa
+// yang digabung, dan konsumsi sebagai jumlah volume per file
+struct MultiCaptureReport {
+    std::vector<CaptureSummary> captures;   // Urutan sama dengan daftar file
+    size_t failed = 0;
+    long long packets = 0;
+    TrafficStatistics stats;
+    QuantileSketch sketch;
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    double consumption = 0.0;
+    double wall_seconds = 0.0;
+    double file_seconds = 0.0;     // Jumlah waktu analisis semua file
+    unsigned threads = 0;
+};
+
+// Daftar file capture dari direktori (semua *.csv, *.csv.gz, *.csv.zst, *.pcap,
+// *.pcapng, *.cap) atau pola glob pada nama file ("data/raw/*.csv",
+// "captures/link?_*.pcap"), diurutkan menurut nama. Format dan kompresi dikenali dari isinya saat dimuat.
+std::vector<std::string> listCaptures(const std::string& pattern);
+
+// Analisis setiap file secara bersamaan, satu NetworkAnalyzer per file
+bool analyzeCaptures(const std::vector<std::string>& files, MultiCaptureReport& report,
+                     double interval_seconds = 300.0, unsigned num_threads = 0);  // 0 = semua core
+
+void printMultiCaptureReport(const MultiCaptureReport& report);
+
+#endif // MULTI_CAPTURE_H
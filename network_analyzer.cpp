@@ -1,282 +1,836 @@
 #include "network_analyzer.h"
+#include "buffered_writer.h"
+#include "decompression_pipeline.h"
+#include "mapped_file.h"
+#include "metrics.h"
+#include "pcap_file.h"
+#include "raw_csv.h"
+#include "series_file.h"
+#include "traffic_aggregator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <map>
-#include <random>
+#include <thread>
 
-// Definisikan M_PI jika tidak tersedia
-#ifndef M_PI
-#define M_PI 3.14159265358979323846
-#endif
+// Batas lebar interval agregasi yang diizinkan (detik)
+const double MIN_INTERVAL_DURATION = 1.0;
+const double MAX_INTERVAL_DURATION = 3600.0;
 
-// Alternatif: gunakan const double
-const double PI = 3.14159265358979323846;
+// Penerbitan parsial mode follow menyalin seluruh snapshot (O(n)). Jeda
+// antar-penerbitan paling sedikit FOLLOW_MIN_PUBLISH_PERIOD dan diperpanjang
+// sehingga penyalinan memakan paling banyak FOLLOW_PUBLISH_BUDGET dari waktu
+// follow, berapa pun panjang deretnya.
+const std::chrono::milliseconds FOLLOW_MIN_PUBLISH_PERIOD(250);
+const double FOLLOW_PUBLISH_BUDGET = 0.1;
 
-NetworkAnalyzer::NetworkAnalyzer() {
-    // Inisialisasi struktur data kosong
+// Teruskan kolom teks satu baris paket ke pelacak aliran
+static void trackFlow(FlowTracker& tracker, const raw_csv::Row& row) {
+    const char* source = row.source.data;
+    const char* source_end = source + row.source.size;
+    const char* destination = row.destination.data;
+    const char* destination_end = destination + row.destination.size;
+    const char* protocol = row.protocol.data;
+    const char* protocol_end = protocol + row.protocol.size;
+    raw_csv::trimField(source, source_end);
+    raw_csv::trimField(destination, destination_end);
+    raw_csv::trimField(protocol, protocol_end);
+    tracker.addPacket(row.timestamp,
+                      source, static_cast<size_t>(source_end - source),
+                      destination, static_cast<size_t>(destination_end - destination),
+                      protocol, static_cast<size_t>(protocol_end - protocol), row.length);
 }
 
-double NetworkAnalyzer::convertToMbps(double bytes, double time_interval) {
+NetworkAnalyzer::NetworkAnalyzer()
+    : published_versions(0), interval_duration(300.0),
+      max_gap_seconds(TrafficAggregator::DEFAULT_MAX_GAP_SECONDS), stop_follow(false),
+      lagrange_degree(3), series_degree(3), flow_tracking(false), flow_top_k(10),
+      parallel_chunk_bytes(1 << 20), quiet(false), quiet_stream(nullptr) {
+    // Inisialisasi snapshot kosong, interval default 5 menit
+    publishSnapshot(std::make_shared<SeriesSnapshot>(interval_duration, lagrange_degree, series_degree));
+}
+
+void NetworkAnalyzer::beginSnapshot(bool keep_current) {
+    if (keep_current) {
+        next_snapshot = std::make_shared<SeriesSnapshot>(*getSnapshot());
+    } else {
+        next_snapshot = std::make_shared<SeriesSnapshot>(interval_duration, lagrange_degree, series_degree);
+    }
+}
+
+void NetworkAnalyzer::publishSnapshot(std::shared_ptr<SeriesSnapshot> snapshot) {
+    snapshot->version = ++published_versions;
+    std::atomic_store(&current_snapshot, std::shared_ptr<const SeriesSnapshot>(std::move(snapshot)));
+}
+
+void NetworkAnalyzer::finishSnapshot() {
+    // Rincian aliran ikut diterbitkan hanya setelah pemuatan selesai menulisnya
+    next_snapshot->flow_tracker = std::move(flow_tracker);
+    publishSnapshot(std::move(next_snapshot));
+}
+
+bool NetworkAnalyzer::setIntervalDuration(double seconds) {
+    if (!(seconds >= MIN_INTERVAL_DURATION && seconds <= MAX_INTERVAL_DURATION)) {
+        std::cerr << "Error: Lebar interval harus antara " << MIN_INTERVAL_DURATION
+                  << " dan " << MAX_INTERVAL_DURATION << " detik." << std::endl;
+        return false;
+    }
+    interval_duration = seconds;
+    return true;
+}
+
+void NetworkAnalyzer::setFlowTracking(bool enabled, size_t top_k) {
+    flow_tracking = enabled;
+    flow_top_k = std::max<size_t>(top_k, 1);
+}
+
+FlowTracker* NetworkAnalyzer::beginFlowTracking() {
+    // Hasil aliran sebelumnya selalu dibuang agar tidak tercampur dengan data baru
+    flow_tracker.reset();
+    if (flow_tracking) flow_tracker = std::make_shared<FlowTracker>(interval_duration, flow_top_k);
+    return flow_tracker.get();
+}
+
+double NetworkAnalyzer::convertToMbps(double bytes, double time_interval) const {
     // Konversi bytes ke Mbps: (bytes * 8 bit/byte) / (waktu_detik * 1e6)
     return (bytes * 8.0) / (time_interval * 1e6);
 }
 
+void NetworkAnalyzer::reportIngestThroughput(const std::string& label, size_t rows,
+                                             size_t bytes, double seconds) {
+    double safe_seconds = std::max(seconds, 1e-9);
+    status() << "Throughput " << label << ": " << std::fixed << std::setprecision(0)
+              << rows / safe_seconds << " baris/s, " << std::setprecision(2)
+              << (bytes / 1e6) / safe_seconds << " MB/s (" << std::setprecision(3)
+              << seconds << " s)" << std::endl;
+}
+
 bool NetworkAnalyzer::loadRawData(const std::string& filename) {
+    if (detectFileCompression(filename) != COMPRESSION_NONE) return loadRawDataCompressed(filename);
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_GETLINE);
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
         return false;
     }
     
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes_read = 0;
+    
     std::string line;
     std::getline(file, line); // Lewati header
+    bytes_read += line.size() + 1;
     
-    std::vector<std::pair<double, int>> raw_packets; // timestamp, length
+    // Paket langsung dilipat ke ember interval, tidak disimpan satu per satu
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    FlowTracker* flows = beginFlowTracking();
     
+    // Baris dibaca dengan getline, tetapi field diurai dengan aturan yang sama
+    // seperti mode mmap dan paralel: baris rusak dilewati dan dihitung
+    raw_csv::ScanResult scanned;
     while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string item;
-        
-        // Parse CSV: Timestamp,Source IP,Destination IP,Protocol,Length
-        std::getline(ss, item, ',');
-        double timestamp = std::stod(item);
-        
-        // Lewati source IP, dest IP, protocol
-        std::getline(ss, item, ','); // Source IP
-        std::getline(ss, item, ','); // Dest IP  
-        std::getline(ss, item, ','); // Protocol
-        
-        std::getline(ss, item, ',');
-        if (!item.empty()) {
-            int length = std::stoi(item);
-            raw_packets.push_back({timestamp, length});
-        }
+        bytes_read += line.size() + 1;
+        raw_csv::ScanResult result = raw_csv::scanRows(line.data(), line.data() + line.size(),
+            [&aggregator, flows](const raw_csv::Row& row) {
+                aggregator.addPacket(row.timestamp, row.length);
+                if (flows) trackFlow(*flows, row);
+            });
+        scanned.rows += result.rows;
+        scanned.skipped_rows += result.skipped_rows;
     }
     
     file.close();
-    std::cout << "Memuat " << raw_packets.size() << " paket dari data mentah." << std::endl;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << scanned.rows << " paket dari data mentah." << std::endl;
+    if (scanned.skipped_rows > 0) {
+        status() << "Melewati " << scanned.skipped_rows << " baris tidak valid." << std::endl;
+    }
+    reportIngestThroughput("getline", scanned.rows, bytes_read, elapsed.count());
+    NA_METRIC_COUNT(ROWS_PARSED, scanned.rows);
+    NA_METRIC_COUNT(ROWS_SKIPPED, scanned.skipped_rows);
+    NA_METRIC_COUNT(BYTES_READ, bytes_read);
     
     // Agregasi paket menjadi interval waktu
-    aggregateData(raw_packets);
+    aggregateData(aggregator);
     
     // Buat pola 24 jam untuk analisis
     generateHourlyPattern();
+    finishSnapshot();
     
     return true;
 }
 
-void NetworkAnalyzer::aggregateData(const std::vector<std::pair<double, int>>& raw_packets) {
-    if (raw_packets.empty()) return;
+bool NetworkAnalyzer::loadRawDataMapped(const std::string& filename) {
+    if (detectFileCompression(filename) != COMPRESSION_NONE) return loadRawDataCompressed(filename);
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_MMAP);
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+        return false;
+    }
     
-    // Cari rentang waktu
-    double min_time = raw_packets[0].first;
-    double max_time = raw_packets.back().first;
-    double duration = max_time - min_time;
+    auto start = std::chrono::steady_clock::now();
     
-    // Buat interval 5 menit
-    const double interval_duration = 300.0; // 5 menit dalam detik
-    std::map<int, std::pair<int, int>> intervals; // interval_id -> (total_bytes, packet_count)
+    // Lewati header langsung di atas buffer hasil mmap
+    const char* body = raw_csv::nextLine(file.begin(), file.end());
     
-    for (const auto& packet : raw_packets) {
-        int interval_id = static_cast<int>((packet.first - min_time) / interval_duration);
-        intervals[interval_id].first += packet.second;  // total bytes
-        intervals[interval_id].second += 1;             // packet count
+    // Rentang timestamp dari baris pertama dan terakhir menentukan ukuran array ember
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    double first_time, last_time;
+    if (raw_csv::firstTimestamp(body, file.end(), first_time) &&
+        raw_csv::lastTimestamp(body, file.end(), last_time)) {
+        aggregator.reserveRange(first_time, last_time);
     }
     
-    // Konversi ke pengukuran bandwidth
-    data.clear();
-    for (const auto& interval_pair : intervals) {
-        TrafficData point;
-        point.timestamp = min_time + (interval_pair.first * interval_duration);
-        point.bandwidth_mbps = convertToMbps(interval_pair.second.first, interval_duration);
-        point.packet_count = interval_pair.second.second;
-        data.push_back(point);
+    // Kolom teks hanya disentuh dalam mode aliran; jalur biasa tetap memakai scan()
+    raw_csv::ScanResult scanned;
+    if (FlowTracker* flows = beginFlowTracking()) {
+        scanned = raw_csv::scanRows(body, file.end(),
+            [&aggregator, flows](const raw_csv::Row& row) {
+                aggregator.addPacket(row.timestamp, row.length);
+                trackFlow(*flows, row);
+            });
+    } else {
+        scanned = raw_csv::scan(body, file.end(),
+            [&aggregator](double timestamp, int length) {
+                aggregator.addPacket(timestamp, length);
+            });
     }
     
-    std::cout << "Diagregasi menjadi " << data.size() << " interval waktu." << std::endl;
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << scanned.rows << " paket dari data mentah (mmap)." << std::endl;
+    if (scanned.skipped_rows > 0) {
+        status() << "Melewati " << scanned.skipped_rows << " baris tidak valid." << std::endl;
+    }
+    reportIngestThroughput("mmap", scanned.rows, file.size(), elapsed.count());
+    NA_METRIC_COUNT(ROWS_PARSED, scanned.rows);
+    NA_METRIC_COUNT(ROWS_SKIPPED, scanned.skipped_rows);
+    NA_METRIC_COUNT(BYTES_READ, file.size());
+    
+    // Agregasi paket menjadi interval waktu
+    aggregateData(aggregator);
+    
+    // Buat pola 24 jam untuk analisis
+    generateHourlyPattern();
+    finishSnapshot();
+    
+    return true;
 }
 
-void NetworkAnalyzer::generateHourlyPattern() {
-    if (data.empty()) return;
+bool NetworkAnalyzer::loadPcap(const std::string& filename) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_PCAP);
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+        return false;
+    }
+    if (pcap_file::detectFormat(file.begin(), file.end()) == pcap_file::FORMAT_UNKNOWN) {
+        std::cerr << "Error: " << filename << " bukan file pcap atau pcapng" << std::endl;
+        return false;
+    }
     
-    // Buat pola 24 jam dari data yang tersedia
-    time_hours.clear();
-    bandwidth.clear();
+    auto start = std::chrono::steady_clock::now();
     
-    // Hitung rata-rata bandwidth dari data nyata
-    double avg_bandwidth = 0;
-    for (const auto& point : data) {
-        avg_bandwidth += point.bandwidth_mbps;
-    }
-    avg_bandwidth /= data.size();
+    // Header Ethernet/IP hanya diurai dalam mode aliran
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    FlowTracker* flows = beginFlowTracking();
+    pcap_file::ScanResult scanned = pcap_file::scanPackets(file.begin(), file.end(), flows != nullptr,
+        [&aggregator, flows](const raw_csv::Row& row) {
+            aggregator.addPacket(row.timestamp, row.length);
+            if (flows) trackFlow(*flows, row);
+        });
     
-    // Buat pola 24 jam yang realistis
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::normal_distribution<> noise(0, avg_bandwidth * 0.1); // 10% noise
+    if (scanned.error) {
+        std::cerr << "Error: " << filename << ": " << scanned.error
+                  << " (setelah " << scanned.packets << " paket)" << std::endl;
+        if (scanned.packets == 0) return false;
+    }
     
-    for (int hour = 0; hour < 24; hour++) {
-        time_hours.push_back(hour);
-        
-        // Pola diurnal: rendah di malam hari, puncak di siang hari
-        double base_factor = 0.4 + 0.6 * (0.5 + 0.5 * sin(PI * (hour - 6) / 12));
-        
-        // Penyesuaian jam sibuk
-        if (hour >= 8 && hour <= 10) base_factor *= 1.3;   // Puncak pagi
-        if (hour >= 14 && hour <= 16) base_factor *= 1.2;  // Puncak siang
-        if (hour >= 19 && hour <= 21) base_factor *= 1.4;  // Puncak sore
-        if (hour >= 0 && hour <= 5) base_factor *= 0.3;    // Rendah malam
-        
-        double hourly_bandwidth = avg_bandwidth * base_factor + noise(gen);
-        bandwidth.push_back(std::max(0.1, hourly_bandwidth)); // Pastikan positif
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << scanned.packets << " paket dari capture pcap." << std::endl;
+    if (scanned.skipped > 0) {
+        status() << "Melewati " << scanned.skipped << " paket tanpa timestamp." << std::endl;
     }
+    reportIngestThroughput("pcap", scanned.packets, file.size(), elapsed.count());
+    NA_METRIC_COUNT(ROWS_PARSED, scanned.packets);
+    NA_METRIC_COUNT(ROWS_SKIPPED, scanned.skipped);
+    NA_METRIC_COUNT(BYTES_READ, file.size());
     
-    std::cout << "Membuat pola lalu lintas 24 jam." << std::endl;
+    aggregateData(aggregator);
+    generateHourlyPattern();
+    finishSnapshot();
+    
+    return true;
 }
 
-double NetworkAnalyzer::lagrangeInterpolation(double target_time) {
-    if (time_hours.empty() || bandwidth.empty()) {
-        std::cerr << "Error: Tidak ada data tersedia untuk interpolasi." << std::endl;
-        return 0.0;
+bool NetworkAnalyzer::loadCapture(const std::string& filename) {
+    char magic[4] = {0, 0, 0, 0};
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+        return false;
     }
+    file.read(magic, sizeof(magic));
+    if (detectCompression(magic, magic + file.gcount()) != COMPRESSION_NONE) {
+        return loadRawDataCompressed(filename);
+    }
+    if (pcap_file::detectFormat(magic, magic + file.gcount()) != pcap_file::FORMAT_UNKNOWN) {
+        return loadPcap(filename);
+    }
+    return loadRawDataMapped(filename);
+}
+
+bool NetworkAnalyzer::loadRawDataCompressed(const std::string& filename) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_COMPRESSED);
+    DecompressionPipeline pipeline;
+    if (!pipeline.open(filename)) return false;
     
-    // Batasi target_time ke rentang yang valid
-    if (target_time < 0) target_time = 0;
-    if (target_time > 23) target_time = 23;
-    
-    int n = time_hours.size();
+    auto start = std::chrono::steady_clock::now();
     
-    // Untuk kecocokan yang tepat, kembalikan nilai yang tepat
-    for (int i = 0; i < n; i++) {
-        if (std::abs(time_hours[i] - target_time) < 0.01) {
-            return bandwidth[i];
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    FlowTracker* flows = beginFlowTracking();
+    raw_csv::ScanResult scanned;
+    auto add_rows = [&aggregator, flows, &scanned](const char* begin, const char* end) {
+        raw_csv::ScanResult result;
+        if (!flows) {
+            result = raw_csv::scan(begin, end, [&aggregator](double timestamp, int length) {
+                aggregator.addPacket(timestamp, length);
+            });
+        } else {
+            result = raw_csv::scanRows(begin, end, [&aggregator, flows](const raw_csv::Row& row) {
+                aggregator.addPacket(row.timestamp, row.length);
+                trackFlow(*flows, row);
+            });
         }
-    }
+        scanned.rows += result.rows;
+        scanned.skipped_rows += result.skipped_rows;
+    };
     
-    // Gunakan interpolasi linear untuk hasil yang lebih stabil
-    // Cari dua titik terdekat
-    int lower_idx = 0, upper_idx = n - 1;
-    
-    for (int i = 0; i < n - 1; i++) {
-        if (time_hours[i] <= target_time && time_hours[i + 1] >= target_time) {
-            lower_idx = i;
-            upper_idx = i + 1;
-            break;
+    // Potongan diurai langsung di buffer pipeline; hanya baris yang terbelah
+    // di batas potongan yang disalin ke pending
+    std::string pending;
+    bool header_skipped = false;
+    DecompressionPipeline::Chunk chunk;
+    while (pipeline.next(chunk)) {
+        const char* begin = chunk.data;
+        const char* end = chunk.data + chunk.size;
+        if (!header_skipped && pending.empty() &&
+            pcap_file::detectFormat(begin, end) != pcap_file::FORMAT_UNKNOWN) {
+            std::cerr << "Error: " << filename << " berisi capture pcap terkompresi; "
+                      << "dekompresi terlebih dahulu" << std::endl;
+            return false;
+        }
+        if (!header_skipped || !pending.empty()) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', chunk.size));
+            if (!newline) {
+                pending.append(begin, end);
+                continue;
+            }
+            pending.append(begin, newline + 1);
+            if (header_skipped) add_rows(pending.data(), pending.data() + pending.size());
+            header_skipped = true;
+            pending.clear();
+            begin = newline + 1;
         }
+        const char* last = end;
+        while (last > begin && last[-1] != '\n') last--;
+        add_rows(begin, last);
+        pending.assign(last, end);
     }
+    // Baris terakhir tanpa '\n'
+    if (header_skipped && !pending.empty()) add_rows(pending.data(), pending.data() + pending.size());
     
-    // Interpolasi linear antara dua titik
-    double x0 = time_hours[lower_idx];
-    double x1 = time_hours[upper_idx];
-    double y0 = bandwidth[lower_idx];
-    double y1 = bandwidth[upper_idx];
+    if (!pipeline.getError().empty()) {
+        std::cerr << "Error: " << filename << ": " << pipeline.getError()
+                  << " (setelah " << scanned.rows << " paket)" << std::endl;
+        if (scanned.rows == 0) return false;
+    }
     
-    if (x1 == x0) return y0; // Hindari pembagian dengan nol
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << scanned.rows << " paket dari data mentah ("
+             << compressionName(pipeline.getCompression()) << ")." << std::endl;
+    if (scanned.skipped_rows > 0) {
+        status() << "Melewati " << scanned.skipped_rows << " baris tidak valid." << std::endl;
+    }
+    // Throughput diukur terhadap ukuran CSV setelah dekompresi agar sebanding dengan mode lain
+    reportIngestThroughput(compressionName(pipeline.getCompression()), scanned.rows,
+                           pipeline.getDecompressedBytes(), elapsed.count());
+    status() << "Terkompresi " << std::setprecision(2) << pipeline.getCompressedBytes() / 1e6
+             << " MB -> " << pipeline.getDecompressedBytes() / 1e6 << " MB; pengurai menunggu "
+             << std::setprecision(3) << pipeline.getConsumerWaitSeconds()
+             << " s, dekompresi menunggu " << pipeline.getProducerWaitSeconds() << " s." << std::endl;
+    NA_METRIC_COUNT(ROWS_PARSED, scanned.rows);
+    NA_METRIC_COUNT(ROWS_SKIPPED, scanned.skipped_rows);
+    NA_METRIC_COUNT(BYTES_READ, pipeline.getCompressedBytes());
+    NA_METRIC_COUNT(BYTES_DECOMPRESSED, pipeline.getDecompressedBytes());
     
-    double result = y0 + (y1 - y0) * (target_time - x0) / (x1 - x0);
+    aggregateData(aggregator);
+    generateHourlyPattern();
+    finishSnapshot();
     
-    // Pastikan hasil masuk akal
-    if (result < 0) result = 0.1;
-    if (result > 10.0) result = 10.0; // Batasi pada maksimum yang masuk akal
+    return true;
+}
+
+void NetworkAnalyzer::aggregateData(TrafficAggregator& aggregator) {
+    NA_METRIC_STAGE(STAGE_AGGREGATE);
+    // Konversi semua ember interval ke pengukuran bandwidth
+    beginSnapshot();
+    size_t outlier_intervals = aggregator.getOutlierIntervals();
+    aggregator.emitAll([this](double interval_start, long long total_bytes, long long packet_count) {
+        appendInterval(interval_start, total_bytes, packet_count);
+    });
+    next_snapshot->computeSeriesStatistics();
     
-    return result;
+    status() << "Diagregasi menjadi " << next_snapshot->series.size() << " interval waktu ("
+              << std::defaultfloat << interval_duration << " detik per interval)." << std::endl;
+    if (aggregator.getOutOfRangePackets() > 0) {
+        status() << "Mengabaikan " << aggregator.getOutOfRangePackets()
+                  << " paket dengan timestamp di luar jangkauan." << std::endl;
+    }
+    if (outlier_intervals > 0) {
+        status() << outlier_intervals << " interval berada jauh dari rentang utama"
+                  << " (periksa timestamp yang melompat)." << std::endl;
+    }
 }
 
-double NetworkAnalyzer::simpsonIntegration() {
-    return simpsonIntegration(0.0, 23.0);
+void NetworkAnalyzer::appendInterval(double interval_start, long long total_bytes, long long packet_count) {
+    TrafficData point;
+    point.timestamp = interval_start;
+    point.bandwidth_mbps = convertToMbps(static_cast<double>(total_bytes), interval_duration);
+    point.packet_count = packet_count;
+    next_snapshot->recordInterval(point);
+    NA_METRIC_COUNT(INTERVALS_PRODUCED, 1);
+}
+
+bool NetworkAnalyzer::loadRawDataParallel(const std::string& filename, unsigned num_threads) {
+    if (detectFileCompression(filename) != COMPRESSION_NONE) return loadRawDataCompressed(filename);
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_PARALLEL);
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+        return false;
+    }
+    
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    auto start = std::chrono::steady_clock::now();
+    const char* body = raw_csv::nextLine(file.begin(), file.end());
+    
+    // Titik awal interval harus sama dengan mode satu thread: paket valid pertama.
+    // Tanpa baris valid sama sekali, deret kosong tetap diterbitkan seperti mode mmap.
+    double min_time = 0.0;
+    FlowTracker* flows = beginFlowTracking();
+    bool has_rows = raw_csv::firstTimestamp(body, file.end(), min_time);
+    
+    // Bagi file menjadi potongan pada batas baris
+    size_t body_size = static_cast<size_t>(file.end() - body);
+    size_t max_chunks = std::max<size_t>(1, body_size / parallel_chunk_bytes);
+    size_t chunk_count = has_rows ? std::min<size_t>(num_threads, max_chunks) : 1;
+    
+    std::vector<const char*> bounds(chunk_count + 1);
+    bounds[0] = body;
+    bounds[chunk_count] = file.end();
+    for (size_t i = 1; i < chunk_count; i++) {
+        const char* guess = body + body_size * i / chunk_count;
+        bounds[i] = std::max(bounds[i - 1], raw_csv::nextLine(guess, file.end()));
+    }
+    
+    // Setiap thread mengurai dan mengelompokkan potongannya sendiri
+    std::vector<TrafficAggregator> partials(chunk_count,
+                                            TrafficAggregator(interval_duration, max_gap_seconds));
+    std::vector<raw_csv::ScanResult> scanned(chunk_count);
+    std::vector<FlowTracker> flow_partials(flows ? chunk_count : 0,
+                                           FlowTracker(interval_duration, flow_top_k));
+    std::vector<std::thread> workers;
+    
+    for (size_t i = 0; i < chunk_count; i++) {
+        workers.emplace_back([&, i]() {
+            NA_METRIC_STAGE_CPU(STAGE_LOAD_PARALLEL);
+            TrafficAggregator& local = partials[i];
+            local.setOrigin(min_time);
+            double first_time, last_time;
+            if (raw_csv::firstTimestamp(bounds[i], bounds[i + 1], first_time) &&
+                raw_csv::lastTimestamp(bounds[i], bounds[i + 1], last_time)) {
+                local.reserveRange(first_time, last_time);
+            }
+            if (flows) {
+                FlowTracker& local_flows = flow_partials[i];
+                local_flows.setOrigin(min_time);
+                scanned[i] = raw_csv::scanRows(bounds[i], bounds[i + 1],
+                    [&local, &local_flows](const raw_csv::Row& row) {
+                        local.addPacket(row.timestamp, row.length);
+                        trackFlow(local_flows, row);
+                    });
+            } else {
+                scanned[i] = raw_csv::scan(bounds[i], bounds[i + 1],
+                    [&local](double timestamp, int length) {
+                        local.addPacket(timestamp, length);
+                    });
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    // Gabungkan hasil parsial; penjumlahan bilangan bulat sehingga hasil identik
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    aggregator.setOrigin(min_time);
+    if (flows) flows->setOrigin(min_time);
+    double last_time;
+    if (raw_csv::lastTimestamp(body, file.end(), last_time)) {
+        aggregator.reserveRange(min_time, last_time);
+    }
+    size_t total_rows = 0, skipped_rows = 0;
+    for (size_t i = 0; i < chunk_count; i++) {
+        aggregator.merge(partials[i]);
+        if (flows) flows->merge(flow_partials[i]);
+        total_rows += scanned[i].rows;
+        skipped_rows += scanned[i].skipped_rows;
+    }
+    
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << total_rows << " paket dari data mentah (paralel, "
+              << chunk_count << " thread)." << std::endl;
+    if (skipped_rows > 0) {
+        status() << "Melewati " << skipped_rows << " baris tidak valid." << std::endl;
+    }
+    reportIngestThroughput("paralel", total_rows, file.size(), elapsed.count());
+    NA_METRIC_COUNT(ROWS_PARSED, total_rows);
+    NA_METRIC_COUNT(ROWS_SKIPPED, skipped_rows);
+    NA_METRIC_COUNT(BYTES_READ, file.size());
+    
+    aggregateData(aggregator);
+    generateHourlyPattern();
+    finishSnapshot();
+    
+    return true;
 }
 
-double NetworkAnalyzer::simpsonIntegration(double start_time, double end_time) {
-    if (bandwidth.empty()) {
-        std::cerr << "Error: Tidak ada data tersedia untuk integrasi." << std::endl;
-        return 0.0;
+bool NetworkAnalyzer::followRawData(const std::string& filename, int poll_interval_ms,
+                                    double idle_timeout_s) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_FOLLOW);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Tidak dapat membuka file " << filename << std::endl;
+        return false;
     }
     
-    // Gunakan titik data yang ada dalam rentang
-    std::vector<double> x_vals, y_vals;
+    stop_follow = false;
+    beginSnapshot();
+    
+    TrafficAggregator aggregator(interval_duration, max_gap_seconds);
+    FlowTracker* flows = beginFlowTracking();
+    auto add_rows = [&aggregator, flows](const char* begin, const char* end) {
+        if (!flows) {
+            return raw_csv::scan(begin, end, [&aggregator](double timestamp, int length) {
+                aggregator.addPacket(timestamp, length);
+            });
+        }
+        return raw_csv::scanRows(begin, end, [&aggregator, flows](const raw_csv::Row& row) {
+            aggregator.addPacket(row.timestamp, row.length);
+            trackFlow(*flows, row);
+        });
+    };
+    std::vector<char> buffer(1 << 16);
+    std::string pending;        // Sisa baris yang belum lengkap
+    bool header_skipped = false;
+    size_t total_rows = 0;
+    auto last_growth = std::chrono::steady_clock::now();
+    
+    // Pembaca melihat interval yang sudah selesai tanpa menunggu follow berhenti,
+    // termasuk tabel ramalan per jam yang diperbarui dari model; rincian aliran
+    // masih ditulis sehingga baru diterbitkan di akhir
+    size_t unpublished = 0;
+    auto next_publish = last_growth;
+    auto publish_partial = [&]() {
+        auto now = std::chrono::steady_clock::now();
+        if (unpublished == 0 || now < next_publish) return;
+        auto partial = std::make_shared<SeriesSnapshot>(*next_snapshot);
+        partial->computeSeriesStatistics();
+        partial->buildForecastTable();
+        publishSnapshot(std::move(partial));
+        auto cost = std::chrono::steady_clock::now() - now;
+        next_publish = now + std::max<std::chrono::steady_clock::duration>(
+            FOLLOW_MIN_PUBLISH_PERIOD,
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(cost / FOLLOW_PUBLISH_BUDGET));
+        status() << "+" << unpublished << " interval (total " << next_snapshot->series.size()
+                 << ")" << std::endl;
+        unpublished = 0;
+    };
     
-    for (size_t i = 0; i < time_hours.size(); i++) {
-        if (time_hours[i] >= start_time && time_hours[i] <= end_time) {
-            x_vals.push_back(time_hours[i]);
-            y_vals.push_back(bandwidth[i]);
+    status() << "Mengikuti " << filename << " (interval selesai ditambahkan secara bertahap)..." << std::endl;
+    
+    while (!stop_follow) {
+        file.read(buffer.data(), buffer.size());
+        std::streamsize got = file.gcount();
+        
+        if (got > 0) {
+            last_growth = std::chrono::steady_clock::now();
+            NA_METRIC_COUNT(BYTES_READ, got);
+            pending.append(buffer.data(), static_cast<size_t>(got));
+            
+            // Hanya baris lengkap yang diurai; sisanya menunggu data berikutnya
+            size_t last_newline = pending.rfind('\n');
+            if (last_newline == std::string::npos) continue;
+            
+            const char* begin = pending.data();
+            const char* end = begin + last_newline + 1;
+            if (!header_skipped) {
+                begin = raw_csv::nextLine(begin, end);
+                header_skipped = true;
+            }
+            
+            total_rows += add_rows(begin, end).rows;
+            pending.erase(0, last_newline + 1);
+            
+            size_t known_events = next_snapshot->anomaly_detector.getEventCount();
+            size_t appended = aggregator.emitCompleted(
+                [this](double interval_start, long long total_bytes, long long packet_count) {
+                    appendInterval(interval_start, total_bytes, packet_count);
+                });
+            if (appended > 0) {
+                unpublished += appended;
+                
+                // Anomali dilaporkan begitu interval yang memuatnya selesai
+                const AnomalyDetector& detector = next_snapshot->anomaly_detector;
+                const std::deque<AnomalyEvent>& events = detector.getEvents();
+                size_t fresh = std::min(detector.getEventCount() - known_events, events.size());
+                for (size_t i = events.size() - fresh; i < events.size(); i++) {
+                    status() << "Anomali " << anomalyKindName(events[i].kind) << " pada "
+                             << std::fixed << std::setprecision(0) << events[i].timestamp << ": "
+                             << std::setprecision(3) << events[i].value << " Mbps (baseline "
+                             << events[i].baseline << " Mbps)" << std::endl;
+                }
+            }
+            publish_partial();
+            continue;
         }
+        
+        // Sudah di akhir file: terbitkan interval yang tertahan lalu tunggu file bertambah
+        publish_partial();
+        file.clear();
+        std::chrono::duration<double> idle = std::chrono::steady_clock::now() - last_growth;
+        if (idle_timeout_s > 0 && idle.count() >= idle_timeout_s) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(poll_interval_ms));
     }
     
-    if (x_vals.size() < 3) {
-        std::cerr << "Error: Titik data tidak cukup untuk aturan Simpson." << std::endl;
-        return 0.0;
+    // Baris terakhir tanpa '\n' dan interval yang masih terbuka dianggap selesai saat berhenti
+    if (header_skipped && !pending.empty()) {
+        total_rows += add_rows(pending.data(), pending.data() + pending.size()).rows;
     }
+    aggregator.emitAll([this](double interval_start, long long total_bytes, long long packet_count) {
+        appendInterval(interval_start, total_bytes, packet_count);
+    });
     
-    // Pastikan kita memiliki jumlah interval genap
-    int n = x_vals.size() - 1;
-    if (n % 2 != 0) {
-        n--; // Gunakan n-1 interval
+    NA_METRIC_COUNT(ROWS_PARSED, total_rows);
+    next_snapshot->computeSeriesStatistics();
+    status() << "Berhenti mengikuti: " << total_rows << " paket, " << next_snapshot->series.size()
+              << " interval waktu." << std::endl;
+    if (aggregator.getLatePackets() > 0) {
+        status() << "Mengabaikan " << aggregator.getLatePackets()
+                  << " paket terlambat untuk interval yang sudah selesai." << std::endl;
     }
     
-    double h = (x_vals[n] - x_vals[0]) / n;
-    double integral = y_vals[0] + y_vals[n];
+    generateHourlyPattern();
+    finishSnapshot();
+    return true;
+}
+
+void NetworkAnalyzer::stopFollow() {
+    stop_follow = true;
+}
+
+void NetworkAnalyzer::generateHourlyPattern() {
+    SeriesSnapshot& snapshot = *next_snapshot;
+    if (snapshot.series.empty()) return;
+    NA_METRIC_STAGE(STAGE_HOURLY_PATTERN);
     
-    // Tambahkan 4 * (suku berindeks ganjil)
-    for (int i = 1; i < n; i += 2) {
-        integral += 4 * y_vals[i];
+    // Model sudah diperbarui per interval saat data dicatat; tinggal diramalkan
+    snapshot.buildForecastTable();
+    const SeasonalForecaster& model = snapshot.forecaster;
+    status() << "Membuat pola 24 jam dari ramalan Holt-Winters (galat satu langkah: ";
+    if (model.getScoredCount() == 0) {
+        // Galat baru dinilai mulai hari kedua capture
+        status() << "belum tersedia";
+    } else {
+        status() << "MAE " << std::defaultfloat << std::setprecision(4) << model.getMeanAbsoluteError()
+                 << " Mbps, RMSE " << model.getRootMeanSquaredError() << " Mbps";
     }
+    status() << ")." << std::endl;
+}
+
+void NetworkAnalyzer::setLagrangeDegree(int degree) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    lagrange_degree = degree;
     
-    // Tambahkan 2 * (suku berindeks genap)
-    for (int i = 2; i < n; i += 2) {
-        integral += 2 * y_vals[i];
+    // Bobot barisentrik bagian dari snapshot: terbitkan salinan dengan bobot baru
+    auto snapshot = std::make_shared<SeriesSnapshot>(*getSnapshot());
+    snapshot->lagrange_degree = degree;
+    snapshot->rebuildNumericIndex();
+    publishSnapshot(std::move(snapshot));
+}
+
+bool NetworkAnalyzer::setSeriesInterpolationDegree(int degree) {
+    if (degree < 1 || degree > 10) {
+        std::cerr << "Error: Derajat interpolasi deret harus antara 1 dan 10." << std::endl;
+        return false;
     }
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    series_degree = degree;
     
-    integral *= h / 3.0;
-    return integral;
+    auto snapshot = std::make_shared<SeriesSnapshot>(*getSnapshot());
+    snapshot->series_degree = degree;
+    publishSnapshot(std::move(snapshot));
+    return true;
+}
+
+double NetworkAnalyzer::lagrangeInterpolation(double target_time) const {
+    return getSnapshot()->lagrangeInterpolation(target_time);
+}
+
+std::vector<double> NetworkAnalyzer::lagrangeInterpolation(const std::vector<double>& target_times) const {
+    return getSnapshot()->lagrangeInterpolation(target_times);
+}
+
+double NetworkAnalyzer::interpolateAt(double unix_time) const {
+    return getSnapshot()->interpolateAt(unix_time);
+}
+
+std::vector<double> NetworkAnalyzer::interpolateAt(const std::vector<double>& unix_times) const {
+    return getSnapshot()->interpolateAt(unix_times);
+}
+
+double NetworkAnalyzer::simpsonIntegration() const {
+    return simpsonIntegration(0.0, 23.0);
+}
+
+double NetworkAnalyzer::simpsonIntegration(double start_time, double end_time) const {
+    return getSnapshot()->simpsonIntegration(start_time, end_time);
+}
+
+std::vector<double> NetworkAnalyzer::simpsonIntegrationBatch(
+        const std::vector<std::pair<double, double>>& ranges) const {
+    return getSnapshot()->simpsonIntegrationBatch(ranges);
+}
+
+IntegrationResult NetworkAnalyzer::integrateAdaptive(double start_hour, double end_hour,
+                                                     double tolerance) const {
+    return getSnapshot()->integrateAdaptive(start_hour, end_hour, tolerance);
+}
+
+IntegrationResult NetworkAnalyzer::integrateSeriesAdaptive(double start_unix, double end_unix,
+                                                           double tolerance, unsigned num_threads) const {
+    return getSnapshot()->integrateSeriesAdaptive(start_unix, end_unix, tolerance, num_threads);
+}
+
+TrafficStatistics NetworkAnalyzer::getStatistics() const {
+    return getSnapshot()->getStatistics();
+}
+
+TrafficStatistics NetworkAnalyzer::getSeriesStatistics() const {
+    return getSnapshot()->getSeriesStatistics();
+}
+
+double NetworkAnalyzer::getPercentile(double percentile) const {
+    return getSnapshot()->getPercentile(percentile);
 }
 
-void NetworkAnalyzer::calculateStatistics() {
-    if (bandwidth.empty()) return;
+double NetworkAnalyzer::getPercentile(double percentile, double start_hour, double end_hour) const {
+    return getSnapshot()->getPercentile(percentile, start_hour, end_hour);
+}
+
+static void printStatistics(const TrafficStatistics& stats) {
+    if (stats.count == 0) return;
     
     std::cout << "\n=== STATISTIK LALU LINTAS ===" << std::endl;
-    std::cout << "Titik data: " << bandwidth.size() << std::endl;
+    std::cout << "Titik data: " << stats.count << std::endl;
     std::cout << "Rata-rata bandwidth: " << std::fixed << std::setprecision(2) 
-              << getAverageBandwidth() << " Mbps" << std::endl;
-    std::cout << "Bandwidth puncak: " << getMaxBandwidth() << " Mbps" << std::endl;
-    std::cout << "Bandwidth minimum: " << getMinBandwidth() << " Mbps" << std::endl;
-    std::cout << "Rasio puncak-ke-rata-rata: " 
-              << getMaxBandwidth() / getAverageBandwidth() << std::endl;
+              << stats.mean << " Mbps" << std::endl;
+    std::cout << "Bandwidth puncak: " << stats.max << " Mbps" << std::endl;
+    std::cout << "Bandwidth minimum: " << stats.min << " Mbps" << std::endl;
+    std::cout << "Simpangan baku: " << stats.stddev << " Mbps" << std::endl;
+    std::cout << "Rasio puncak-ke-rata-rata: " << stats.peak_to_average << std::endl;
+}
+
+static void printAnomalies(const AnomalyDetector& detector, size_t max_events) {
+    std::cout << "\n=== ANOMALI LALU LINTAS ===" << std::endl;
+    std::cout << "Lonjakan: " << detector.getEventCount(ANOMALY_BURST)
+              << ", penurunan: " << detector.getEventCount(ANOMALY_DROP)
+              << ", pergeseran level naik/turun: " << detector.getEventCount(ANOMALY_SHIFT_UP)
+              << "/" << detector.getEventCount(ANOMALY_SHIFT_DOWN) << std::endl;
+    
+    const std::deque<AnomalyEvent>& events = detector.getEvents();
+    size_t first = events.size() > max_events ? events.size() - max_events : 0;
+    if (first > 0 || detector.getEventCount() > events.size()) {
+        std::cout << "(" << events.size() - first << " peristiwa terbaru dari "
+                  << detector.getEventCount() << ")" << std::endl;
+    }
+    for (size_t i = first; i < events.size(); i++) {
+        const AnomalyEvent& event = events[i];
+        std::cout << std::fixed << std::setprecision(0) << event.timestamp << "  "
+                  << std::left << std::setw(11) << anomalyKindName(event.kind) << std::right
+                  << std::setprecision(3) << event.value << " Mbps (baseline " << event.baseline
+                  << " Mbps, skor " << std::setprecision(1) << event.score << ")" << std::endl;
+    }
+    std::cout << std::setprecision(3);
 }
 
-double NetworkAnalyzer::getMaxBandwidth() {
-    if (bandwidth.empty()) return 0.0;
-    return *std::max_element(bandwidth.begin(), bandwidth.end());
+void NetworkAnalyzer::calculateStatistics() const {
+    printStatistics(getStatistics());
 }
 
-double NetworkAnalyzer::getMinBandwidth() {
-    if (bandwidth.empty()) return 0.0;
-    return *std::min_element(bandwidth.begin(), bandwidth.end());
+double NetworkAnalyzer::getMaxBandwidth() const {
+    return getStatistics().max;
 }
 
-double NetworkAnalyzer::getAverageBandwidth() {
-    if (bandwidth.empty()) return 0.0;
-    double sum = 0.0;
-    for (double bw : bandwidth) {
-        sum += bw;
-    }
-    return sum / bandwidth.size();
+double NetworkAnalyzer::getMinBandwidth() const {
+    return getStatistics().min;
 }
 
-void NetworkAnalyzer::displayResults() {
+double NetworkAnalyzer::getAverageBandwidth() const {
+    return getStatistics().mean;
+}
+
+void NetworkAnalyzer::displayResults() const {
+    // Seluruh laporan dari satu versi data meskipun pemuatan ulang berjalan
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
     std::cout << "\n=== HASIL ANALISIS LALU LINTAS JARINGAN ===" << std::endl;
     std::cout << std::fixed << std::setprecision(3);
     
-    calculateStatistics();
+    printStatistics(snapshot->getStatistics());
+    
+    if (snapshot->getSeriesSketch().count() > 0) {
+        std::cout << "\n=== PERSENTIL BANDWIDTH PER INTERVAL ===" << std::endl;
+        std::cout << "p50: " << snapshot->getPercentile(50) << " Mbps" << std::endl;
+        std::cout << "p95: " << snapshot->getPercentile(95) << " Mbps" << std::endl;
+        std::cout << "p99: " << snapshot->getPercentile(99) << " Mbps" << std::endl;
+        std::cout << "(galat relatif maksimum " << snapshot->getPercentileErrorBound() * 100 << "%)" << std::endl;
+    }
+    
+    if (!snapshot->getSeries().empty()) printAnomalies(snapshot->getAnomalyDetector(), 10);
     
     std::cout << "\n=== PREDIKSI INTERPOLASI LAGRANGE ===" << std::endl;
     std::vector<double> test_times = {8.5, 12.5, 15.5, 20.5};
     
-    for (double t : test_times) {
-        double predicted = lagrangeInterpolation(t);
-        std::cout << "Prediksi bandwidth pada " << t 
-                  << ":30 = " << predicted << " Mbps" << std::endl;
+    std::vector<double> predicted = snapshot->lagrangeInterpolation(test_times);
+    for (size_t i = 0; i < test_times.size(); i++) {
+        std::cout << "Prediksi bandwidth pada " << test_times[i] 
+                  << ":30 = " << predicted[i] << " Mbps" << std::endl;
     }
     
     std::cout << "\n=== HASIL INTEGRASI SIMPSON ===" << std::endl;
-    double total_consumption = simpsonIntegration();
+    double total_consumption = snapshot->simpsonIntegration(0.0, 23.0);
     double average_bandwidth = total_consumption / 24.0;
     
     std::cout << "Total konsumsi bandwidth (24 jam): " 
@@ -286,50 +840,170 @@ void NetworkAnalyzer::displayResults() {
     
     // Hitung beberapa interval
     std::cout << "\nKonsumsi bandwidth berdasarkan periode waktu:" << std::endl;
-    std::cout << "Pagi (6-12): " << simpsonIntegration(6, 12) << " Mbps×jam" << std::endl;
-    std::cout << "Siang (12-18): " << simpsonIntegration(12, 18) << " Mbps×jam" << std::endl;
-    std::cout << "Sore (18-24): " << simpsonIntegration(18, 24) << " Mbps×jam" << std::endl;
+    std::cout << "Pagi (6-12): " << snapshot->simpsonIntegration(6, 12) << " Mbps×jam" << std::endl;
+    std::cout << "Siang (12-18): " << snapshot->simpsonIntegration(12, 18) << " Mbps×jam" << std::endl;
+    std::cout << "Sore (18-24): " << snapshot->simpsonIntegration(18, 24) << " Mbps×jam" << std::endl;
 }
 
-void NetworkAnalyzer::printInterpolationTable() {
+void NetworkAnalyzer::printInterpolationTable() const {
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    const TimeSeriesStore& hourly = snapshot->getHourly();
     std::cout << "\n=== DATA BANDWIDTH PER JAM ===" << std::endl;
     std::cout << "Waktu (jam)\tBandwidth (Mbps)" << std::endl;
     std::cout << "--------------------------------" << std::endl;
     
-    for (size_t i = 0; i < time_hours.size(); i++) {
-        std::cout << std::fixed << std::setprecision(1) << time_hours[i] 
-                  << "\t\t" << std::setprecision(3) << bandwidth[i] << std::endl;
+    for (size_t i = 0; i < hourly.size(); i++) {
+        std::cout << std::fixed << std::setprecision(1) << hourly.timestampAt(i) 
+                  << "\t\t" << std::setprecision(3) << hourly.bandwidthAt(i) << std::endl;
+    }
+}
+
+std::vector<double> NetworkAnalyzer::getProtocolBandwidth(size_t interval_index) const {
+    return protocolBandwidth(*getSnapshot(), interval_index);
+}
+
+std::vector<double> NetworkAnalyzer::protocolBandwidth(const SeriesSnapshot& snapshot,
+                                                       size_t interval_index) const {
+    std::vector<double> result;
+    const FlowTracker* flow_tracker = snapshot.getFlowTracker();
+    const TimeSeriesStore& series = snapshot.getSeries();
+    if (!flow_tracker || interval_index >= series.size()) return result;
+    
+    std::vector<long long> bytes = flow_tracker->protocolBytesAt(series.timestampAt(interval_index));
+    result.resize(flow_tracker->getProtocolNames().size(), 0.0);
+    for (size_t p = 0; p < bytes.size(); p++) {
+        result[p] = convertToMbps(static_cast<double>(bytes[p]), snapshot.getIntervalDuration());
     }
+    return result;
+}
+
+std::vector<AnomalyEvent> NetworkAnalyzer::getAnomalies() const {
+    const std::deque<AnomalyEvent>& events = getSnapshot()->getAnomalyDetector().getEvents();
+    return std::vector<AnomalyEvent>(events.begin(), events.end());
 }
 
-void NetworkAnalyzer::exportResults(const std::string& filename) {
-    std::ofstream outFile(filename);
+void NetworkAnalyzer::printAnomalyReport(size_t max_events) const {
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    if (snapshot->getSeries().empty()) {
+        std::cout << "Deret interval kosong; muat data mentah terlebih dahulu." << std::endl;
+        return;
+    }
+    printAnomalies(snapshot->getAnomalyDetector(), max_events);
+}
+
+void NetworkAnalyzer::printFlowReport(size_t top_n) const {
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    const FlowTracker* flow_tracker = snapshot->getFlowTracker();
+    const TimeSeriesStore& series = snapshot->getSeries();
+    if (!flow_tracker) {
+        std::cout << "Rincian aliran tidak tersedia. Aktifkan mode aliran lalu muat ulang data mentah." << std::endl;
+        return;
+    }
     
-    outFile << "Time_Hour,Bandwidth_Mbps,Interpolated_8.5,Interpolated_12.5,Interpolated_15.5,Interpolated_20.5" << std::endl;
+    const std::vector<std::string>& protocols = flow_tracker->getProtocolNames();
+    std::vector<long long> totals = flow_tracker->protocolTotals();
+    long long total_bytes = 0;
+    for (long long bytes : totals) total_bytes += bytes;
     
-    double interp_8_5 = lagrangeInterpolation(8.5);
-    double interp_12_5 = lagrangeInterpolation(12.5);
-    double interp_15_5 = lagrangeInterpolation(15.5);
-    double interp_20_5 = lagrangeInterpolation(20.5);
+    std::cout << "\n=== RINCIAN PER PROTOKOL ===" << std::endl;
+    std::cout << "Protokol\tTotal (MB)\tPorsi" << std::endl;
+    for (size_t p = 0; p < protocols.size(); p++) {
+        double share = total_bytes > 0 ? 100.0 * totals[p] / total_bytes : 0.0;
+        std::cout << protocols[p] << "\t\t" << std::fixed << std::setprecision(2)
+                  << totals[p] / 1e6 << "\t\t" << share << "%" << std::endl;
+    }
     
-    for (size_t i = 0; i < time_hours.size(); i++) {
-        outFile << time_hours[i] << "," << bandwidth[i];
-        
-        // Tambahkan nilai interpolasi untuk perbandingan
-        if (i == 0) {
-            outFile << "," << interp_8_5 << "," << interp_12_5 
-                    << "," << interp_15_5 << "," << interp_20_5;
+    // Protokol yang mendorong interval puncak
+    const double* bandwidth = series.bandwidth();
+    size_t peak = static_cast<size_t>(std::max_element(bandwidth, bandwidth + series.size()) - bandwidth);
+    std::vector<double> peak_bandwidth = protocolBandwidth(*snapshot, peak);
+    if (!peak_bandwidth.empty()) {
+        std::cout << "\nInterval puncak (timestamp " << std::setprecision(0) << series.timestampAt(peak)
+                  << ", " << std::setprecision(3) << series.bandwidthAt(peak) << " Mbps):" << std::endl;
+        for (size_t p = 0; p < protocols.size(); p++) {
+            if (peak_bandwidth[p] > 0.0) {
+                std::cout << "  " << protocols[p] << ": " << peak_bandwidth[p] << " Mbps" << std::endl;
+            }
+        }
+    }
+    
+    // Nilai sebenarnya berada di antara (byte - galat) dan byte
+    auto print_talkers = [top_n](const std::string& title, const std::vector<HeavyHitter>& talkers) {
+        std::cout << "\n" << title << std::endl;
+        std::cout << "Alamat\t\t\tByte\t\tGalat maks" << std::endl;
+        for (size_t i = 0; i < talkers.size() && i < top_n; i++) {
+            std::cout << std::left << std::setw(24) << talkers[i].key << std::right
+                      << talkers[i].bytes << "\t" << talkers[i].error << std::endl;
+        }
+    };
+    print_talkers("=== PENGIRIM TERATAS ===", flow_tracker->getTopSources());
+    print_talkers("=== PENERIMA TERATAS ===", flow_tracker->getTopDestinations());
+}
+
+bool NetworkAnalyzer::exportResults(const std::string& filename, ExportFormat format) const {
+    NA_METRIC_STAGE(STAGE_EXPORT);
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    const TimeSeriesStore& series = snapshot->getSeries();
+    if (series.empty()) {
+        std::cerr << "Error: Deret interval kosong; tidak ada yang diekspor." << std::endl;
+        return false;
+    }
+    
+    BufferedWriter out;
+    if (!out.open(filename)) return false;
+    
+    bool json = format == EXPORT_JSONL;
+    if (!json) {
+        out.append("timestamp,bandwidth_mbps,packet_count,interpolated_mbps,integrated_mbps_hours\n");
+    }
+    
+    // Setiap interval adalah rata-rata bandwidth, sehingga integral tepatnya
+    // adalah jumlah bandwidth × lebar interval
+    double half_interval = snapshot->getIntervalDuration() / 2.0;
+    double interval_hours = snapshot->getIntervalDuration() / 3600.0;
+    const double* timestamps = series.timestamps();
+    const double* bandwidth = series.bandwidth();
+    const int64_t* packets = series.packets();
+    double integrated = 0.0;
+    for (size_t i = 0; i < series.size(); i++) {
+        double interpolated = snapshot->evaluateSeries(timestamps[i] + half_interval);
+        integrated += bandwidth[i] * interval_hours;
+        if (json) {
+            out.append("{\"timestamp\":");
+            out.appendNumber(timestamps[i], "null");
+            out.append(",\"bandwidth_mbps\":");
+            out.appendNumber(bandwidth[i], "null");
+            out.append(",\"packet_count\":");
+            out.appendNumber(static_cast<long long>(packets[i]));
+            out.append(",\"interpolated_mbps\":");
+            out.appendNumber(interpolated, "null");
+            out.append(",\"integrated_mbps_hours\":");
+            out.appendNumber(integrated, "null");
+            out.append("}\n");
         } else {
-            outFile << ",,,";
+            out.appendNumber(timestamps[i]);
+            out.append(',');
+            out.appendNumber(bandwidth[i]);
+            out.append(',');
+            out.appendNumber(static_cast<long long>(packets[i]));
+            out.append(',');
+            out.appendNumber(interpolated);
+            out.append(',');
+            out.appendNumber(integrated);
+            out.append('\n');
         }
-        outFile << std::endl;
     }
     
-    outFile.close();
-    std::cout << "Hasil diekspor ke " << filename << std::endl;
+    if (!out.close()) return false;
+    NA_METRIC_COUNT(BYTES_WRITTEN, out.getBytesWritten());
+    status() << "Hasil " << series.size() << " interval (" << out.getBytesWritten() / 1e6 << " MB, "
+             << out.getWriteCalls() << " penulisan) diekspor ke "
+             << (filename.empty() || filename == "-" ? "stdout" : filename) << std::endl;
+    return true;
 }
 
 bool NetworkAnalyzer::loadProcessedData(const std::string& filename) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Tidak dapat membuka file terproses " << filename << std::endl;
@@ -339,8 +1013,11 @@ bool NetworkAnalyzer::loadProcessedData(const std::string& filename) {
     std::string line;
     std::getline(file, line); // Lewati header
     
-    time_hours.clear();
-    bandwidth.clear();
+    // CSV terproses hanya berisi tabel per jam. Snapshot baru dimulai kosong
+    // agar tabel tidak pernah bersanding dengan deret interval dari pemuatan
+    // lain yang bukan sumbernya.
+    beginSnapshot();
+    TimeSeriesStore& hourly = next_snapshot->hourly;
     
     while (std::getline(file, line)) {
         std::stringstream ss(line);
@@ -352,24 +1029,192 @@ bool NetworkAnalyzer::loadProcessedData(const std::string& filename) {
         std::getline(ss, item, ',');
         double bw = std::stod(item);
         
-        time_hours.push_back(time);
-        bandwidth.push_back(bw);
+        hourly.append(time, bw);
     }
     
     file.close();
-    std::cout << "Memuat " << time_hours.size() << " titik data terproses." << std::endl;
+    next_snapshot->rebuildNumericIndex();
+    status() << "Memuat " << hourly.size() << " titik data terproses." << std::endl;
+    publishSnapshot(std::move(next_snapshot));
+    return true;
+}
+
+bool NetworkAnalyzer::saveProcessedData(const std::string& filename) const {
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    const TimeSeriesStore& hourly = snapshot->getHourly();
+    BufferedWriter out;
+    if (!out.open(filename)) return false;
+    
+    out.append("Time_Hour,Bandwidth_Mbps\n");
+    for (size_t i = 0; i < hourly.size(); i++) {
+        out.appendNumber(hourly.timestampAt(i));
+        out.append(',');
+        out.appendNumber(hourly.bandwidthAt(i));
+        out.append('\n');
+    }
+    
+    if (!out.close()) return false;
+    NA_METRIC_COUNT(BYTES_WRITTEN, out.getBytesWritten());
+    status() << "Data terproses disimpan ke " << filename << std::endl;
     return true;
 }
 
-void NetworkAnalyzer::saveProcessedData(const std::string& filename) {
-    std::ofstream outFile(filename);
+bool NetworkAnalyzer::saveProcessedBinary(const std::string& filename) const {
+    NA_METRIC_STAGE(STAGE_SAVE_BINARY);
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: Tidak dapat menulis file biner " << filename << std::endl;
+        return false;
+    }
+    
+    // Kolom penyimpanan sudah sama dengan kolom file; ditulis tanpa salinan
+    std::shared_ptr<const SeriesSnapshot> snapshot = getSnapshot();
+    const TimeSeriesStore& series = snapshot->getSeries();
+    const TimeSeriesStore& hourly = snapshot->getHourly();
+    size_t count = series.size();
     
-    outFile << "Time_Hour,Bandwidth_Mbps" << std::endl;
+    const void* columns[series_file::COLUMN_COUNT] = {
+        series.timestamps(), series.bandwidth(), series.packets(),
+        hourly.timestamps(), hourly.bandwidth()
+    };
+    size_t column_bytes[series_file::COLUMN_COUNT] = {
+        count * sizeof(double), count * sizeof(double), count * sizeof(int64_t),
+        hourly.size() * sizeof(double), hourly.size() * sizeof(double)
+    };
     
-    for (size_t i = 0; i < time_hours.size(); i++) {
-        outFile << time_hours[i] << "," << bandwidth[i] << std::endl;
+    series_file::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, series_file::MAGIC, sizeof(header.magic));
+    header.version = series_file::VERSION;
+    header.endian_mark = series_file::ENDIAN_MARK;
+    header.interval_count = count;
+    header.hourly_count = hourly.size();
+    header.interval_duration = snapshot->getIntervalDuration();
+    
+    size_t offset = series_file::alignUp(sizeof(header));
+    for (int c = 0; c < series_file::COLUMN_COUNT; c++) {
+        header.column_offset[c] = offset;
+        header.column_crc[c] = series_file::crc32(columns[c], column_bytes[c]);
+        offset = series_file::alignUp(offset + column_bytes[c]);
     }
+    header.header_crc = series_file::crc32(&header, offsetof(series_file::Header, header_crc));
     
+    // Tulis header dan kolom dengan padding nol di antaranya
+    const char padding[series_file::COLUMN_ALIGNMENT] = {};
+    size_t written = sizeof(header);
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (int c = 0; c < series_file::COLUMN_COUNT; c++) {
+        outFile.write(padding, header.column_offset[c] - written);
+        outFile.write(static_cast<const char*>(columns[c]), column_bytes[c]);
+        written = header.column_offset[c] + column_bytes[c];
+    }
+    
+    if (!outFile) {
+        std::cerr << "Error: Gagal menulis file biner " << filename << std::endl;
+        return false;
+    }
     outFile.close();
-    std::cout << "Data terproses disimpan ke " << filename << std::endl;
-}
\ No newline at end of file
+    NA_METRIC_COUNT(BYTES_WRITTEN, written);
+    status() << "Data terproses (" << count << " interval) disimpan ke " << filename << std::endl;
+    return true;
+}
+
+bool NetworkAnalyzer::loadProcessedBinary(const std::string& filename) {
+    std::lock_guard<std::mutex> writer(writer_mutex);
+    NA_METRIC_STAGE(STAGE_LOAD_BINARY);
+    auto start = std::chrono::steady_clock::now();
+    
+    MappedFile file;
+    if (!file.open(filename)) {
+        std::cerr << "Error: Tidak dapat membuka file terproses " << filename << std::endl;
+        return false;
+    }
+    
+    series_file::Header header;
+    if (file.size() < sizeof(header)) {
+        std::cerr << "Error: File biner terlalu kecil: " << filename << std::endl;
+        return false;
+    }
+    std::memcpy(&header, file.begin(), sizeof(header));
+    
+    if (std::memcmp(header.magic, series_file::MAGIC, sizeof(header.magic)) != 0 ||
+        header.endian_mark != series_file::ENDIAN_MARK) {
+        std::cerr << "Error: Bukan file deret biner yang valid: " << filename << std::endl;
+        return false;
+    }
+    if (header.version != series_file::VERSION) {
+        std::cerr << "Error: Versi format biner " << header.version << " tidak didukung." << std::endl;
+        return false;
+    }
+    if (header.header_crc != series_file::crc32(&header, offsetof(series_file::Header, header_crc))) {
+        std::cerr << "Error: Checksum header tidak cocok pada " << filename << std::endl;
+        return false;
+    }
+    
+    // Lebar interval menentukan ukuran tabel musiman; nilai rusak ditolak
+    // sebelum dipakai (negasi juga menolak NaN)
+    if (!(header.interval_duration >= MIN_INTERVAL_DURATION &&
+          header.interval_duration <= MAX_INTERVAL_DURATION)) {
+        std::cerr << "Error: Lebar interval tidak valid pada " << filename << ": "
+                  << header.interval_duration << std::endl;
+        return false;
+    }
+    
+    // Validasi batas dan checksum setiap kolom sebelum data dipakai
+    uint64_t rows[series_file::COLUMN_COUNT] = {
+        header.interval_count, header.interval_count, header.interval_count,
+        header.hourly_count, header.hourly_count
+    };
+    const char* columns[series_file::COLUMN_COUNT];
+    for (int c = 0; c < series_file::COLUMN_COUNT; c++) {
+        // Jumlah baris dibandingkan sebelum dikalikan agar tidak meluap
+        if (header.column_offset[c] > file.size() || rows[c] > (file.size() - header.column_offset[c]) / 8) {
+            std::cerr << "Error: File biner terpotong: " << filename << std::endl;
+            return false;
+        }
+        // Kolom dibaca langsung sebagai double/int64 dari hasil mmap (selaras halaman)
+        if (header.column_offset[c] % 8 != 0) {
+            std::cerr << "Error: Offset kolom " << c << " tidak selaras pada " << filename << std::endl;
+            return false;
+        }
+        uint64_t bytes = rows[c] * 8;
+        columns[c] = file.begin() + header.column_offset[c];
+        if (series_file::crc32(columns[c], bytes) != header.column_crc[c]) {
+            std::cerr << "Error: Checksum kolom " << c << " tidak cocok pada " << filename << std::endl;
+            return false;
+        }
+    }
+    
+    // Kolom sudah dalam representasi biner; cukup disalin tanpa penguraian
+    size_t count = header.interval_count;
+    const double* timestamps = reinterpret_cast<const double*>(columns[series_file::COL_TIMESTAMP]);
+    const double* bandwidths = reinterpret_cast<const double*>(columns[series_file::COL_BANDWIDTH]);
+    const int64_t* packets = reinterpret_cast<const int64_t*>(columns[series_file::COL_PACKETS]);
+    
+    interval_duration = header.interval_duration;
+    beginSnapshot();
+    flow_tracker.reset();   // File biner tidak menyimpan rincian aliran
+    SeriesSnapshot& snapshot = *next_snapshot;
+    snapshot.series.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        TrafficData point;
+        point.timestamp = timestamps[i];
+        point.bandwidth_mbps = bandwidths[i];
+        point.packet_count = packets[i];
+        snapshot.recordInterval(point);
+    }
+    snapshot.computeSeriesStatistics();
+    
+    const double* hours = reinterpret_cast<const double*>(columns[series_file::COL_HOUR]);
+    const double* hour_bandwidth = reinterpret_cast<const double*>(columns[series_file::COL_HOUR_BANDWIDTH]);
+    snapshot.hourly.assign(hours, hour_bandwidth, nullptr, header.hourly_count);
+    snapshot.rebuildNumericIndex();
+    finishSnapshot();
+    NA_METRIC_COUNT(BYTES_READ, file.size());
+    
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    status() << "Memuat " << count << " interval dan " << header.hourly_count
+              << " titik per jam dari file biner (" << std::fixed << std::setprecision(3)
+              << elapsed.count() << " ms)." << std::endl;
+    return true;
+}
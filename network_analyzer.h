@@ -9,52 +9,164 @@
 #include <cmath>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "series_snapshot.h"
 
-struct TrafficData {
-    double timestamp;      // Cap waktu Unix
-    double bandwidth_mbps; // Bandwidth dalam Mbps
-    int packet_count;      // Jumlah paket dalam interval ini
+class TrafficAggregator;
+
+// Format ekspor deret resolusi penuh
+enum ExportFormat {
+    EXPORT_CSV,
+    EXPORT_JSONL    // JSON Lines: satu objek per interval
 };
 
 class NetworkAnalyzer {
 private:
-    std::vector<TrafficData> data;
-    std::vector<double> time_hours;    // Waktu dalam jam (0-24)
-    std::vector<double> bandwidth;     // Nilai bandwidth yang sesuai
+    // Versi data yang sedang dibaca kueri; hanya diakses lewat
+    // std::atomic_load/atomic_store sehingga pemuatan ulang dapat
+    // menukarnya selagi thread lain masih memegang versi lama
+    std::shared_ptr<const SeriesSnapshot> current_snapshot;
+    
+    // Versi berikutnya yang sedang dibangun oleh pemuatan; tidak pernah
+    // terlihat oleh pembaca sebelum diterbitkan
+    std::shared_ptr<SeriesSnapshot> next_snapshot;
+    std::shared_ptr<FlowTracker> flow_tracker;
+    uint64_t published_versions;
+    std::mutex writer_mutex;           // Satu penulis pada satu waktu
+    
+    double interval_duration;          // Lebar ember agregasi dalam detik
+    double max_gap_seconds;            // Celah terjauh yang masih diperluas di array ember padat
+    std::atomic<bool> stop_follow;     // Sinyal berhenti untuk mode follow
+    int lagrange_degree;
+    int series_degree;
+    
+    // Mode aliran opsional: rincian per protokol dan pengirim/penerima teratas
+    bool flow_tracking;
+    size_t flow_top_k;
+    
+    size_t parallel_chunk_bytes;       // Potongan minimum per thread pada pemuatan paralel
+    
+    // Pesan status pemuatan; saat mode senyap diarahkan ke ostream tanpa
+    // streambuf (semua tulisan dibuang) agar banyak analyzer dapat berjalan
+    // bersamaan tanpa mengacak keluaran
+    bool quiet;
+    mutable std::ostream quiet_stream;
+    std::ostream& status() const { return quiet ? quiet_stream : std::cout; }
     
     // Fungsi pembantu
-    double convertToMbps(double bytes, double time_interval);
-    void aggregateData(const std::vector<std::pair<double, int>>& raw_packets);
+    double convertToMbps(double bytes, double time_interval) const;
+    void aggregateData(TrafficAggregator& aggregator);
+    void appendInterval(double interval_start, long long total_bytes, long long packet_count);
     void generateHourlyPattern();
+    void reportIngestThroughput(const std::string& label, size_t rows,
+                                size_t bytes, double seconds);
+    void beginSnapshot(bool keep_current = false);   // Mulai versi berikutnya
+    void publishSnapshot(std::shared_ptr<SeriesSnapshot> snapshot);
+    void finishSnapshot();   // Terbitkan next_snapshot beserta rincian aliran
+    FlowTracker* beginFlowTracking();   // nullptr jika mode aliran tidak aktif
+    std::vector<double> protocolBandwidth(const SeriesSnapshot& snapshot, size_t interval_index) const;
     
 public:
     // Konstruktor
     NetworkAnalyzer();
     
-    // Pemuatan dan pemrosesan data
+    // Versi data saat ini. Pembaca yang menjalankan banyak kueri sebaiknya
+    // memegang snapshot ini sekali dan memanggil metodenya langsung.
+    std::shared_ptr<const SeriesSnapshot> getSnapshot() const {
+        return std::atomic_load(&current_snapshot);
+    }
+    
+    // Konfigurasi agregasi
+    bool setIntervalDuration(double seconds);  // 1 detik sampai 1 jam
+    double getIntervalDuration() const { return interval_duration; }
+    // Paket lebih jauh dari ini di luar rentang yang teramati (misalnya jam yang
+    // melompat) tetap dihitung, tetapi disimpan jarang alih-alih memperluas array
+    void setMaxTimestampGap(double seconds) { if (seconds > 0) max_gap_seconds = seconds; }
+    
+    // Pemuatan dan pemrosesan data. Setiap pemuatan membangun snapshot baru
+    // dan menerbitkannya di akhir; kueri dari thread lain tetap berjalan atas
+    // versi sebelumnya selama pemuatan berlangsung. CSV mentah yang
+    // terkompresi gzip/zstd dikenali otomatis oleh semua pemuat CSV.
     bool loadRawData(const std::string& filename);
+    bool loadRawDataMapped(const std::string& filename);  // Mode cepat: mmap + from_chars
+    bool loadRawDataParallel(const std::string& filename, unsigned num_threads = 0); // 0 = semua core
+    void setParallelChunkBytes(size_t bytes) { parallel_chunk_bytes = std::max<size_t>(1, bytes); }
+    bool loadRawDataCompressed(const std::string& filename);  // gzip/zstd, dekompresi pada thread tersendiri
+    bool loadPcap(const std::string& filename);     // pcap klasik atau pcapng, tanpa libpcap
+    bool loadCapture(const std::string& filename);  // Pilih pemuat dari magic number
+    bool followRawData(const std::string& filename, int poll_interval_ms = 1000,
+                       double idle_timeout_s = 0);  // 0 = ikuti sampai stopFollow()
+    void stopFollow();
+    void setFlowTracking(bool enabled, size_t top_k = 10);  // Berlaku untuk pemuatan berikutnya
+    bool isFlowTracking() const { return flow_tracking; }
+    void setQuiet(bool enabled) { quiet = enabled; }  // Sembunyikan pesan status pemuatan
     bool loadProcessedData(const std::string& filename);
-    void saveProcessedData(const std::string& filename);
+    bool saveProcessedData(const std::string& filename) const;   // Ekspor CSV 24 jam
+    bool loadProcessedBinary(const std::string& filename); // Format kolumnar, lihat series_file.h
+    bool saveProcessedBinary(const std::string& filename) const;
+    
+    // Metode numerik (semua membaca snapshot saat ini)
+    double lagrangeInterpolation(double target_time) const;
+    std::vector<double> lagrangeInterpolation(const std::vector<double>& target_times) const;
+    void setLagrangeDegree(int degree);
+    int getLagrangeDegree() const { return lagrange_degree; }
+    
+    // Interpolasi langsung pada timestamp Unix atas seluruh deret teragregasi;
+    // setelah interval terakhir nilainya ramalan Holt-Winters
+    double interpolateAt(double unix_time) const;
+    std::vector<double> interpolateAt(const std::vector<double>& unix_times) const;
+    double forecastAt(double unix_time) const { return getSnapshot()->forecastAt(unix_time); }
+    bool setSeriesInterpolationDegree(int degree);  // 1 sampai 10
+    int getSeriesInterpolationDegree() const { return series_degree; }
+    double simpsonIntegration() const;
+    double simpsonIntegration(double start_time, double end_time) const;
+    std::vector<double> simpsonIntegrationBatch(const std::vector<std::pair<double, double>>& ranges) const;
     
-    // Metode numerik
-    double lagrangeInterpolation(double target_time);
-    double simpsonIntegration();
-    double simpsonIntegration(double start_time, double end_time);
+    // Integrasi Simpson adaptif atas interpolan, bukan hanya titik sampel (Mbps×jam).
+    // tolerance adalah galat absolut yang diizinkan dalam Mbps×jam.
+    IntegrationResult integrateAdaptive(double start_hour, double end_hour,
+                                        double tolerance = 1e-6) const;
+    IntegrationResult integrateSeriesAdaptive(double start_unix, double end_unix,
+                                              double tolerance = 1e-6,
+                                              unsigned num_threads = 0) const;  // 0 = semua core
     
     // Fungsi analisis
-    void calculateStatistics();
-    double getMaxBandwidth();
-    double getMinBandwidth();
-    double getAverageBandwidth();
+    void calculateStatistics() const;
+    TrafficStatistics getStatistics() const;        // Tabel per jam
+    TrafficStatistics getSeriesStatistics() const;  // Seluruh deret interval
+    double getPercentile(double percentile) const;  // 0-100, atas seluruh deret interval
+    double getPercentile(double percentile, double start_hour, double end_hour) const;
+    double getPercentileErrorBound() const { return getSnapshot()->getPercentileErrorBound(); }
+    
+    // Agregat atas interval yang dimulai dalam [start_unix, end_unix), O(log n)
+    RangeAggregate aggregateRange(double start_unix, double end_unix) const {
+        return getSnapshot()->aggregateRange(start_unix, end_unix);
+    }
+    double getMaxBandwidth() const;
+    double getMinBandwidth() const;
+    double getAverageBandwidth() const;
+    
+    std::vector<double> getProtocolBandwidth(size_t interval_index) const;  // Mbps per protokol
+    
+    // Anomali yang terdeteksi saat interval dicatat (terlama lebih dulu, dibatasi
+    // DetectorParameters::max_events); salinan sehingga aman setelah pemuatan ulang
+    std::vector<AnomalyEvent> getAnomalies() const;
     
     // Fungsi keluaran
-    void displayResults();
-    void exportResults(const std::string& filename);
-    void printInterpolationTable();
+    void displayResults() const;
+    // Satu baris per interval: bandwidth, jumlah paket, interpolan deret pada
+    // titik tengah interval, dan integral kumulatif (Mbps×jam). "" atau "-"
+    // menulis ke stdout.
+    bool exportResults(const std::string& filename, ExportFormat format = EXPORT_CSV) const;
+    void printInterpolationTable() const;
+    void printFlowReport(size_t top_n = 10) const;
+    void printAnomalyReport(size_t max_events = 20) const;   // Peristiwa terbaru
     
-    // Getter
-    size_t getDataSize() const { return data.size(); }
-    const std::vector<TrafficData>& getData() const { return data; }
+    // Getter. Deret, rollup, dan hasil mode aliran dibaca lewat getSnapshot()
+    // agar referensinya tetap hidup selama snapshot dipegang.
+    size_t getDataSize() const { return getSnapshot()->getSeries().size(); }
 };
 
 #endif // NETWORK_ANALYZER_H
\ No newline at end of file
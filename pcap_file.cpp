@@ -0,0 +1,181 @@
+#include "pcap_file.h"
+#include <cstdio>
+
+namespace pcap_file {
+
+namespace {
+
+// Jenis link (LINKTYPE_*) yang diurai
+const uint32_t LINKTYPE_NULL = 0;
+const uint32_t LINKTYPE_ETHERNET = 1;
+const uint32_t LINKTYPE_RAW = 101;
+const uint32_t LINKTYPE_LINUX_SLL = 113;
+const uint32_t LINKTYPE_IPV4 = 228;
+const uint32_t LINKTYPE_IPV6 = 229;
+const uint32_t LINKTYPE_LINUX_SLL2 = 276;
+
+const uint16_t ETHERTYPE_IPV4 = 0x0800;
+const uint16_t ETHERTYPE_ARP = 0x0806;
+const uint16_t ETHERTYPE_IPV6 = 0x86DD;
+
+uint16_t bigEndian16(const unsigned char* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+const char* transportName(unsigned protocol, bool ipv6) {
+    switch (protocol) {
+        case 1: return "ICMP";
+        case 2: return "IGMP";
+        case 6: return "TCP";
+        case 17: return "UDP";
+        case 47: return "GRE";
+        case 50: return "ESP";
+        case 58: return "ICMPv6";
+        case 132: return "SCTP";
+        default: return ipv6 ? "IPv6" : "IPv4";
+    }
+}
+
+void formatIPv4(const unsigned char* address, char* out) {
+    std::snprintf(out, 16, "%u.%u.%u.%u", address[0], address[1], address[2], address[3]);
+}
+
+// Notasi RFC 5952: heksadesimal huruf kecil, deret nol terpanjang (>= 2 grup) disingkat "::"
+void formatIPv6(const unsigned char* address, char* out) {
+    uint16_t groups[8];
+    for (int i = 0; i < 8; i++) groups[i] = bigEndian16(address + 2 * i);
+
+    int best_start = -1, best_length = 0;
+    for (int i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            i++;
+            continue;
+        }
+        int start = i;
+        while (i < 8 && groups[i] == 0) i++;
+        if (i - start > best_length) {
+            best_start = start;
+            best_length = i - start;
+        }
+    }
+    if (best_length < 2) best_start = -1;
+
+    char* p = out;
+    for (int i = 0; i < 8; i++) {
+        if (i == best_start) {
+            *p++ = ':';
+            if (i == 0) *p++ = ':';
+            i += best_length - 1;
+            continue;
+        }
+        p += std::snprintf(p, 6, "%x", groups[i]);
+        if (i < 7) *p++ = ':';
+    }
+    *p = '\0';
+}
+
+void decodeIPv4(const unsigned char* packet, size_t size, HeaderText& text) {
+    if (size < 20 || (packet[0] >> 4) != 4) return;
+    formatIPv4(packet + 12, text.source);
+    formatIPv4(packet + 16, text.destination);
+    text.protocol = transportName(packet[9], false);
+}
+
+void decodeIPv6(const unsigned char* packet, size_t size, HeaderText& text) {
+    if (size < 40 || (packet[0] >> 4) != 6) return;
+    formatIPv6(packet + 8, text.source);
+    formatIPv6(packet + 24, text.destination);
+
+    // Lewati header ekstensi untuk menemukan protokol transport
+    unsigned next = packet[6];
+    size_t offset = 40;
+    while ((next == 0 || next == 43 || next == 44 || next == 60) && offset + 8 <= size) {
+        size_t length = next == 44 ? 8 : (static_cast<size_t>(packet[offset + 1]) + 1) * 8;
+        next = packet[offset];
+        offset += length;
+    }
+    text.protocol = transportName(next, true);
+}
+
+void decodeNetwork(uint16_t ethertype, const unsigned char* packet, size_t size, HeaderText& text) {
+    if (ethertype == ETHERTYPE_IPV4) {
+        decodeIPv4(packet, size, text);
+    } else if (ethertype == ETHERTYPE_IPV6) {
+        decodeIPv6(packet, size, text);
+    } else if (ethertype == ETHERTYPE_ARP) {
+        text.protocol = "ARP";
+        // Alamat protokol pengirim dan target untuk ARP atas IPv4
+        if (size >= 28 && bigEndian16(packet + 2) == ETHERTYPE_IPV4 && packet[4] == 6 && packet[5] == 4) {
+            formatIPv4(packet + 14, text.source);
+            formatIPv4(packet + 24, text.destination);
+        }
+    }
+}
+
+// IPv4 atau IPv6 menurut nibble versi, untuk link tanpa ethertype
+void decodeRawIP(const unsigned char* packet, size_t size, HeaderText& text) {
+    if (size == 0) return;
+    unsigned version = packet[0] >> 4;
+    if (version == 4) decodeIPv4(packet, size, text);
+    if (version == 6) decodeIPv6(packet, size, text);
+}
+
+} // namespace
+
+Format detectFormat(const char* begin, const char* end) {
+    if (end - begin < 4) return FORMAT_UNKNOWN;
+    uint32_t magic;
+    std::memcpy(&magic, begin, sizeof(magic));
+    if (magic == PCAP_MAGIC_MICRO || magic == PCAP_MAGIC_NANO ||
+        magic == swap32(PCAP_MAGIC_MICRO) || magic == swap32(PCAP_MAGIC_NANO)) {
+        return FORMAT_PCAP;
+    }
+    if (magic == PCAPNG_SECTION_HEADER) return FORMAT_PCAPNG;
+    return FORMAT_UNKNOWN;
+}
+
+void decodeHeaders(uint32_t linktype, const unsigned char* frame, size_t captured, HeaderText& text) {
+    text.source[0] = '\0';
+    text.destination[0] = '\0';
+    text.protocol = "LAINNYA";
+
+    switch (linktype) {
+        case LINKTYPE_ETHERNET: {
+            if (captured < 14) return;
+            size_t offset = 12;
+            uint16_t ethertype = bigEndian16(frame + offset);
+            // Tag VLAN 802.1Q / 802.1ad
+            while ((ethertype == 0x8100 || ethertype == 0x88A8 || ethertype == 0x9100) &&
+                   offset + 6 <= captured) {
+                offset += 4;
+                ethertype = bigEndian16(frame + offset);
+            }
+            offset += 2;
+            decodeNetwork(ethertype, frame + offset, captured - offset, text);
+            break;
+        }
+        case LINKTYPE_NULL: {
+            // Keluarga alamat dalam urutan byte mesin perekam: 2 = IPv4, 24/28/30 = IPv6
+            if (captured < 4) return;
+            decodeRawIP(frame + 4, captured - 4, text);
+            break;
+        }
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+            decodeRawIP(frame, captured, text);
+            break;
+        case LINKTYPE_LINUX_SLL:
+            if (captured < 16) return;
+            decodeNetwork(bigEndian16(frame + 14), frame + 16, captured - 16, text);
+            break;
+        case LINKTYPE_LINUX_SLL2:
+            if (captured < 20) return;
+            decodeNetwork(bigEndian16(frame), frame + 20, captured - 20, text);
+            break;
+        default:
+            break;
+    }
+}
+
+} // namespace pcap_file
@@ -0,0 +1,264 @@
+#ifndef PCAP_FILE_H
+#define PCAP_FILE_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "raw_csv.h"
+
+// Pembaca capture pcap klasik dan pcapng tanpa libpcap, langsung di atas
+// buffer hasil mmap. Untuk setiap paket hanya timestamp dan panjang asli
+// (orig_len, sama dengan kolom Length Wireshark) yang dibaca; header
+// Ethernet/IP baru diurai jika pemanggil meminta kolom teks (mode aliran).
+// Paket diteruskan sebagai raw_csv::Row sehingga jalur agregasi sama
+// dengan pemuatan CSV.
+namespace pcap_file {
+
+enum Format {
+    FORMAT_UNKNOWN,
+    FORMAT_PCAP,
+    FORMAT_PCAPNG
+};
+
+const uint32_t PCAP_MAGIC_MICRO = 0xA1B2C3D4;
+const uint32_t PCAP_MAGIC_NANO = 0xA1B23C4D;
+const uint32_t PCAPNG_SECTION_HEADER = 0x0A0D0D0A;
+const uint32_t PCAPNG_BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+const uint32_t PCAPNG_INTERFACE_DESCRIPTION = 1;
+const uint32_t PCAPNG_OBSOLETE_PACKET = 2;
+const uint32_t PCAPNG_SIMPLE_PACKET = 3;
+const uint32_t PCAPNG_ENHANCED_PACKET = 6;
+
+inline uint16_t swap16(uint16_t v) {
+    return static_cast<uint16_t>((v >> 8) | (v << 8));
+}
+
+inline uint32_t swap32(uint32_t v) {
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+inline uint64_t swap64(uint64_t v) {
+    return (static_cast<uint64_t>(swap32(static_cast<uint32_t>(v))) << 32) | swap32(static_cast<uint32_t>(v >> 32));
+}
+
+inline uint16_t load16(const char* p, bool swap) {
+    uint16_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swap ? swap16(v) : v;
+}
+
+inline uint32_t load32(const char* p, bool swap) {
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return swap ? swap32(v) : v;
+}
+
+// Kenali format dari magic number di awal file
+Format detectFormat(const char* begin, const char* end);
+
+// Statistik hasil pemindaian
+struct ScanResult {
+    size_t packets = 0;
+    size_t skipped = 0;             // Paket tanpa timestamp atau interface tidak dikenal
+    const char* error = nullptr;    // Alasan berhenti jika file rusak atau terpotong
+};
+
+// Kolom teks hasil penguraian header; berlaku sampai paket berikutnya
+struct HeaderText {
+    char source[48];
+    char destination[48];
+    const char* protocol;
+};
+
+// Urai header link/jaringan satu frame. Alamat IPv4/IPv6 ditulis dalam
+// notasi standar; protokol adalah lapisan transport (TCP, UDP, ICMP, ...).
+// Frame yang tidak dikenali menghasilkan alamat kosong.
+void decodeHeaders(uint32_t linktype, const unsigned char* frame, size_t captured, HeaderText& text);
+
+namespace detail {
+
+// Susun Row dari satu paket dan teruskan ke pemanggil
+template <typename Callback>
+void emitPacket(double timestamp, uint32_t original_length, uint32_t linktype,
+                const char* frame, uint32_t captured, bool with_headers,
+                raw_csv::Row& row, HeaderText& text, Callback& on_packet) {
+    row.timestamp = timestamp;
+    row.length = original_length > static_cast<uint32_t>(INT_MAX)
+        ? INT_MAX : static_cast<int>(original_length);
+    if (with_headers) {
+        decodeHeaders(linktype, reinterpret_cast<const unsigned char*>(frame), captured, text);
+        row.source = {text.source, std::strlen(text.source)};
+        row.destination = {text.destination, std::strlen(text.destination)};
+        row.protocol = {text.protocol, std::strlen(text.protocol)};
+    }
+    on_packet(row);
+}
+
+template <typename Callback>
+ScanResult scanClassic(const char* begin, const char* end, bool with_headers, Callback& on_packet) {
+    ScanResult result;
+    if (end - begin < 24) {
+        result.error = "header pcap terpotong";
+        return result;
+    }
+
+    uint32_t magic;
+    std::memcpy(&magic, begin, sizeof(magic));
+    bool swap = magic == swap32(PCAP_MAGIC_MICRO) || magic == swap32(PCAP_MAGIC_NANO);
+    if (swap) magic = swap32(magic);
+    double fraction_scale = magic == PCAP_MAGIC_NANO ? 1e-9 : 1e-6;
+    uint32_t linktype = load32(begin + 20, swap) & 0x0FFFFFFF;   // Bit atas berisi info FCS
+
+    raw_csv::Row row;
+    HeaderText text;
+    const char* p = begin + 24;
+    while (end - p >= 16) {
+        uint32_t seconds = load32(p, swap);
+        uint32_t fraction = load32(p + 4, swap);
+        uint32_t captured = load32(p + 8, swap);
+        uint32_t original = load32(p + 12, swap);
+        if (captured > static_cast<size_t>(end - p - 16)) {
+            result.error = "record pcap terpotong";
+            return result;
+        }
+        emitPacket(seconds + fraction * fraction_scale, original, linktype, p + 16, captured,
+                   with_headers, row, text, on_packet);
+        result.packets++;
+        p += 16 + captured;
+    }
+    if (p != end) result.error = "record pcap terakhir terpotong";
+    return result;
+}
+
+template <typename Callback>
+ScanResult scanNextGeneration(const char* begin, const char* end, bool with_headers,
+                              Callback& on_packet) {
+    struct Interface {
+        uint32_t linktype;
+        uint64_t units_per_second;   // Dari opsi if_tsresol; bawaan mikrodetik
+        int64_t offset_seconds;      // Dari opsi if_tsoffset
+    };
+
+    ScanResult result;
+    std::vector<Interface> interfaces;
+    bool swap = false;
+    raw_csv::Row row;
+    HeaderText text;
+
+    const char* p = begin;
+    while (end - p >= 12) {
+        uint32_t raw_type;
+        std::memcpy(&raw_type, p, sizeof(raw_type));
+        if (raw_type == PCAPNG_SECTION_HEADER) {
+            // Urutan byte ditentukan ulang di setiap section
+            uint32_t byte_order;
+            std::memcpy(&byte_order, p + 8, sizeof(byte_order));
+            if (byte_order != PCAPNG_BYTE_ORDER_MAGIC && byte_order != swap32(PCAPNG_BYTE_ORDER_MAGIC)) {
+                result.error = "byte-order magic pcapng tidak valid";
+                return result;
+            }
+            swap = byte_order != PCAPNG_BYTE_ORDER_MAGIC;
+            interfaces.clear();
+        }
+
+        uint32_t type = swap ? swap32(raw_type) : raw_type;
+        uint32_t total_length = load32(p + 4, swap);
+        if (total_length < 12 || total_length % 4 != 0 ||
+            total_length > static_cast<size_t>(end - p)) {
+            result.error = "blok pcapng terpotong atau rusak";
+            return result;
+        }
+        const char* body = p + 8;
+        size_t body_length = total_length - 12;
+
+        if (type == PCAPNG_INTERFACE_DESCRIPTION && body_length >= 8) {
+            Interface iface = {load16(body, swap), 1000000, 0};
+            // Opsi: kode (2), panjang (2), nilai dengan padding 4 byte
+            const char* option = body + 8;
+            const char* options_end = body + body_length;
+            while (options_end - option >= 4) {
+                uint16_t code = load16(option, swap);
+                uint16_t length = load16(option + 2, swap);
+                const char* value = option + 4;
+                if (code == 0 || length > options_end - value) break;
+                if (code == 9 && length >= 1) {
+                    // if_tsresol: bit atas 0 = 10^-n, 1 = 2^-n
+                    uint8_t resolution = static_cast<uint8_t>(*value);
+                    unsigned exponent = resolution & 0x7F;
+                    uint64_t units = 1;
+                    bool binary = (resolution & 0x80) != 0;
+                    if ((binary && exponent > 63) || (!binary && exponent > 19)) {
+                        result.error = "resolusi timestamp pcapng tidak didukung";
+                        return result;
+                    }
+                    for (unsigned i = 0; i < exponent; i++) units *= binary ? 2 : 10;
+                    iface.units_per_second = units;
+                } else if (code == 14 && length >= 8) {
+                    uint64_t offset;
+                    std::memcpy(&offset, value, sizeof(offset));
+                    iface.offset_seconds = static_cast<int64_t>(swap ? swap64(offset) : offset);
+                }
+                option = value + ((length + 3u) & ~3u);
+            }
+            interfaces.push_back(iface);
+        } else if ((type == PCAPNG_ENHANCED_PACKET || type == PCAPNG_OBSOLETE_PACKET) &&
+                   body_length >= 20) {
+            // EPB: interface_id (4); Packet Block lama: interface_id (2) + drops (2)
+            uint32_t interface_id = type == PCAPNG_ENHANCED_PACKET
+                ? load32(body, swap) : load16(body, swap);
+            uint64_t ticks = (static_cast<uint64_t>(load32(body + 4, swap)) << 32) |
+                             load32(body + 8, swap);
+            uint32_t captured = load32(body + 12, swap);
+            uint32_t original = load32(body + 16, swap);
+            if (captured > body_length - 20) {
+                result.error = "paket pcapng melebihi bloknya";
+                return result;
+            }
+            if (interface_id >= interfaces.size()) {
+                result.skipped++;
+            } else {
+                // Bagian detik dan pecahan dipisah agar resolusi nanodetik tidak hilang
+                const Interface& iface = interfaces[interface_id];
+                uint64_t units = iface.units_per_second;
+                double timestamp = static_cast<double>(ticks / units) +
+                                   static_cast<double>(ticks % units) / static_cast<double>(units) +
+                                   static_cast<double>(iface.offset_seconds);
+                emitPacket(timestamp, original, iface.linktype, body + 20, captured,
+                           with_headers, row, text, on_packet);
+                result.packets++;
+            }
+        } else if (type == PCAPNG_SIMPLE_PACKET) {
+            result.skipped++;   // Tidak memiliki timestamp
+        }
+        p += total_length;
+    }
+    if (p != end) result.error = "blok pcapng terakhir terpotong";
+    return result;
+}
+
+} // namespace detail
+
+// Pindai seluruh capture dalam [begin, end). Untuk setiap paket dengan
+// timestamp, on_packet(row) dipanggil; kolom teks row hanya diisi jika
+// with_headers. Paket sebelum bagian yang rusak tetap diteruskan.
+template <typename Callback>
+ScanResult scanPackets(const char* begin, const char* end, bool with_headers, Callback&& on_packet) {
+    switch (detectFormat(begin, end)) {
+        case FORMAT_PCAP:
+            return detail::scanClassic(begin, end, with_headers, on_packet);
+        case FORMAT_PCAPNG:
+            return detail::scanNextGeneration(begin, end, with_headers, on_packet);
+        default: {
+            ScanResult result;
+            result.error = "bukan file pcap atau pcapng";
+            return result;
+        }
+    }
+}
+
+} // namespace pcap_file
+
+#endif // PCAP_FILE_H
@@ -0,0 +1,120 @@
+#include "quantile_sketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+QuantileSketch::QuantileSketch(double relative_accuracy, size_t max_bins)
+    : relative_accuracy(relative_accuracy),
+      gamma((1.0 + relative_accuracy) / (1.0 - relative_accuracy)),
+      log_gamma(std::log(gamma)),
+      max_bins(std::max<size_t>(max_bins, 1)),
+      min_key(0), zero_count(0), total_count(0),
+      min_value(std::numeric_limits<double>::infinity()),
+      max_value(-std::numeric_limits<double>::infinity()) {
+    bins.reserve(this->max_bins);
+}
+
+void QuantileSketch::clear() {
+    bins.clear();
+    min_key = 0;
+    zero_count = 0;
+    total_count = 0;
+    min_value = std::numeric_limits<double>::infinity();
+    max_value = -std::numeric_limits<double>::infinity();
+}
+
+int QuantileSketch::keyOf(double value) const {
+    return static_cast<int>(std::ceil(std::log(value) / log_gamma));
+}
+
+double QuantileSketch::valueOf(int key) const {
+    // Titik tengah relatif ember (gamma^(k-1), gamma^k]
+    return 2.0 * std::pow(gamma, key) / (gamma + 1.0);
+}
+
+void QuantileSketch::add(double value) {
+    if (std::isnan(value)) return;
+
+    total_count++;
+    if (value < min_value) min_value = value;
+    if (value > max_value) max_value = value;
+
+    if (value <= MIN_POSITIVE) {
+        zero_count++;
+        return;
+    }
+    addToKey(keyOf(value), 1);
+}
+
+void QuantileSketch::addToKey(int key, uint64_t count) {
+    if (bins.empty()) {
+        min_key = key;
+        bins.push_back(count);
+        return;
+    }
+
+    int max_key = min_key + static_cast<int>(bins.size()) - 1;
+    if (key < min_key) {
+        // Perluas ke bawah; jika melebihi batas, masukkan ke ember terendah
+        size_t span = static_cast<size_t>(max_key - key) + 1;
+        if (span > max_bins) {
+            bins[0] += count;
+            return;
+        }
+        bins.insert(bins.begin(), static_cast<size_t>(min_key - key), 0);
+        min_key = key;
+        bins[0] += count;
+    } else if (key > max_key) {
+        size_t span = static_cast<size_t>(key - min_key) + 1;
+        if (span > max_bins) {
+            // Gabungkan ember terendah agar rentang tetap max_bins
+            size_t drop = span - max_bins;
+            uint64_t collapsed = 0;
+            size_t merged = std::min(drop + 1, bins.size());
+            for (size_t i = 0; i < merged; i++) collapsed += bins[i];
+            if (drop >= bins.size()) {
+                bins.assign(1, collapsed);
+            } else {
+                bins.erase(bins.begin(), bins.begin() + static_cast<std::ptrdiff_t>(drop));
+                bins[0] = collapsed;
+            }
+            min_key += static_cast<int>(drop);
+        }
+        bins.resize(static_cast<size_t>(key - min_key) + 1, 0);
+        bins.back() += count;
+    } else {
+        bins[static_cast<size_t>(key - min_key)] += count;
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    // Sketsa harus memakai akurasi yang sama; ember digabung per kunci
+    if (other.total_count == 0) return;
+
+    for (size_t i = 0; i < other.bins.size(); i++) {
+        if (other.bins[i] > 0) addToKey(other.min_key + static_cast<int>(i), other.bins[i]);
+    }
+    zero_count += other.zero_count;
+    total_count += other.total_count;
+    min_value = std::min(min_value, other.min_value);
+    max_value = std::max(max_value, other.max_value);
+}
+
+double QuantileSketch::quantile(double q) const {
+    if (total_count == 0) return 0.0;
+    if (q <= 0.0) return min_value;
+    if (q >= 1.0) return max_value;
+
+    double rank = q * static_cast<double>(total_count - 1);
+    uint64_t cumulative = zero_count;
+    if (static_cast<double>(cumulative) > rank) return std::max(0.0, min_value);
+
+    for (size_t i = 0; i < bins.size(); i++) {
+        cumulative += bins[i];
+        if (static_cast<double>(cumulative) > rank) {
+            double value = valueOf(min_key + static_cast<int>(i));
+            return std::min(std::max(value, min_value), max_value);
+        }
+    }
+    return max_value;
+}
@@ -0,0 +1,52 @@
+#ifndef QUANTILE_SKETCH_H
+#define QUANTILE_SKETCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sketsa kuantil streaming dengan memori tetap (gaya DDSketch).
+//
+// Nilai positif dikelompokkan ke ember logaritmik dengan rasio
+// gamma = (1 + a) / (1 - a). Kuantil yang dikembalikan berada dalam galat
+// relatif a dari nilai sebenarnya pada peringkat tersebut, berapa pun
+// panjang deretnya. Jumlah ember dibatasi max_bins; jika rentang nilai
+// melebihinya, ember terendah digabung sehingga jaminan galat hanya
+// melemah untuk kuantil paling bawah. Dua sketsa dapat digabung (merge)
+// tanpa kehilangan akurasi.
+class QuantileSketch {
+private:
+    double relative_accuracy;
+    double gamma;
+    double log_gamma;
+    size_t max_bins;
+    std::vector<uint64_t> bins;   // bins[i] untuk kunci min_key + i
+    int min_key;
+    uint64_t zero_count;          // Nilai <= MIN_POSITIVE
+    uint64_t total_count;
+    double min_value;
+    double max_value;
+
+public:
+    static constexpr double MIN_POSITIVE = 1e-9;
+
+    explicit QuantileSketch(double relative_accuracy = 0.01, size_t max_bins = 2048);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+    void clear();
+
+    // q dalam [0, 1]; mengembalikan 0 jika sketsa kosong
+    double quantile(double q) const;
+
+    uint64_t count() const { return total_count; }
+    double getRelativeAccuracy() const { return relative_accuracy; }
+    size_t memoryBytes() const { return max_bins * sizeof(uint64_t); }
+
+private:
+    int keyOf(double value) const;
+    void addToKey(int key, uint64_t count);
+    double valueOf(int key) const;
+};
+
+#endif // QUANTILE_SKETCH_H
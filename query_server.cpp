@@ -0,0 +1,605 @@
+#include "query_server.h"
+#include "buffered_writer.h"
+#include "network_analyzer.h"
+#include <iostream>
+
+#ifdef __linux__
+
+#include <arpa/inet.h>
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+enum QueryType {
+    QUERY_PREDICT,
+    QUERY_PREDICT_UNIX,
+    QUERY_INTEGRATE,
+    QUERY_INTEGRATE_UNIX,
+    QUERY_PERCENTILE,
+    QUERY_AGGREGATE,
+    QUERY_STATS,
+    QUERY_SERVER_STATS,
+    QUERY_PING,
+    QUERY_INVALID,
+    QUERY_TOO_LONG
+};
+
+const char* const QUERY_NAMES[] = {"predict", "predict-unix", "integrate", "integrate-unix",
+                                   "percentile", "aggregate", "stats", "server-stats", "ping"};
+
+const size_t READ_CHUNK = 64 * 1024;
+const int MAX_EVENTS = 256;
+const size_t MAX_PENDING_OUTPUT = 1 << 20;   // Berhenti membaca klien yang tidak membaca jawabannya
+// Batas byte yang dibaca dari satu koneksi per bangun; sisanya tetap di soket
+// dan dibaca pada bangun berikutnya (picu-level), sehingga klien yang mengirim
+// ledakan permintaan tidak dapat menumbuhkan input, batch, dan output tanpa batas
+const size_t MAX_READ_PER_EVENT = 2 * READ_CHUNK;
+
+bool parseNumber(const char* first, const char* last, double& value) {
+    if (first == last) return false;
+    auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last && std::isfinite(value);
+}
+
+// Nilai tak hingga/NaN ditulis sebagai null agar setiap baris tetap JSON valid
+void appendNumber(std::string& out, double value) {
+    if (!std::isfinite(value)) {
+        out += "null";
+        return;
+    }
+    char text[MAX_NUMBER_CHARS];
+    out.append(text, formatNumber(text, value));
+}
+
+void appendField(std::string& out, const char* name, double value) {
+    out += ",\"";
+    out += name;
+    out += "\":";
+    appendNumber(out, value);
+}
+
+void appendQuery(std::string& out, const char* name) {
+    out += "{\"query\":\"";
+    out += name;
+    out += '"';
+}
+
+} // namespace
+
+struct QueryServer::Request {
+    int fd;
+    QueryType type;
+    double a;
+    double b;
+    size_t slot;               // Posisi dalam batch jenisnya
+    Clock::time_point received;
+};
+
+QueryServer::QueryServer(const NetworkAnalyzer& analyzer, const ServerOptions& options)
+    : analyzer(analyzer), options(options), listen_fd(-1), epoll_fd(-1), wake_fd(-1), listening(false),
+      socket_device(0), socket_inode(0) {}
+
+QueryServer::~QueryServer() {
+    closeAll();
+}
+
+bool QueryServer::start() {
+    closeAll();
+    started = Clock::now();
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        std::cerr << "Error: Tidak dapat membuat epoll/eventfd: " << std::strerror(errno) << std::endl;
+        closeAll();
+        return false;
+    }
+
+    if (!options.socket_path.empty()) {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (options.socket_path.size() >= sizeof(address.sun_path)) {
+            std::cerr << "Error: Path soket terlalu panjang: " << options.socket_path << std::endl;
+            closeAll();
+            return false;
+        }
+        std::memcpy(address.sun_path, options.socket_path.c_str(), options.socket_path.size() + 1);
+
+        // Soket sisa daemon yang sudah mati dihapus. Soket yang masih menerima
+        // koneksi milik daemon lain dan tidak disentuh; file biasa dengan nama
+        // sama dibiarkan sehingga bind gagal.
+        struct stat existing;
+        if (lstat(options.socket_path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) {
+            int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            bool stale = probe >= 0 &&
+                         connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 &&
+                         errno == ECONNREFUSED;
+            if (probe >= 0) ::close(probe);
+            if (!stale) {
+                std::cerr << "Error: Soket sudah dipakai: " << options.socket_path << std::endl;
+                closeAll();
+                return false;
+            }
+            unlink(options.socket_path.c_str());
+        }
+        listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listen_fd < 0 || bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            stat(options.socket_path.c_str(), &existing) != 0) {
+            std::cerr << "Error: Tidak dapat membuka soket " << options.socket_path << ": "
+                      << std::strerror(errno) << std::endl;
+            closeAll();
+            return false;
+        }
+        socket_device = existing.st_dev;
+        socket_inode = existing.st_ino;
+    } else {
+        if (options.port < 0 || options.port > 65535) {
+            std::cerr << "Error: Port TCP tidak valid: " << options.port << std::endl;
+            closeAll();
+            return false;
+        }
+        sockaddr_in address;
+        std::memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(options.port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        int reuse = 1;
+        if (listen_fd < 0 ||
+            setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) != 0 ||
+            bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::cerr << "Error: Tidak dapat membuka port " << options.port << ": "
+                      << std::strerror(errno) << std::endl;
+            closeAll();
+            return false;
+        }
+    }
+    listening = true;
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd;
+    bool registered = listen(listen_fd, SOMAXCONN) == 0 &&
+                      epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &event) == 0;
+    event.data.fd = wake_fd;
+    registered = registered && epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) == 0;
+    if (!registered) {
+        std::cerr << "Error: Tidak dapat mendengarkan soket: " << std::strerror(errno) << std::endl;
+        closeAll();
+        return false;
+    }
+    return true;
+}
+
+int QueryServer::getPort() const {
+    if (!options.socket_path.empty() || listen_fd < 0) return -1;
+    sockaddr_in address;
+    socklen_t length = sizeof(address);
+    if (getsockname(listen_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) return -1;
+    return ntohs(address.sin_port);
+}
+
+void QueryServer::stop() {
+    // Hanya write(2) agar aman dari penangan sinyal
+    if (wake_fd < 0) return;
+    uint64_t one = 1;
+    ssize_t written = write(wake_fd, &one, sizeof(one));
+    (void)written;
+}
+
+bool QueryServer::run() {
+    if (epoll_fd < 0) {
+        std::cerr << "Error: Server belum dimulai." << std::endl;
+        return false;
+    }
+    epoll_event events[MAX_EVENTS];
+    std::vector<Request> batch;
+    std::vector<int> touched;
+    bool stopping = false;
+
+    while (!stopping) {
+        int ready = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: epoll_wait gagal: " << std::strerror(errno) << std::endl;
+            closeAll();
+            return false;
+        }
+
+        batch.clear();
+        touched.clear();
+        for (int i = 0; i < ready; i++) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd) {
+                acceptConnections();
+                continue;
+            }
+            if (fd == wake_fd) {
+                stopping = true;
+                continue;
+            }
+            auto found = connections.find(fd);
+            if (found == connections.end()) continue;
+            Connection& connection = found->second;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readConnection(connection, batch);
+            if (events[i].events & EPOLLOUT) flushConnection(connection);
+            touched.push_back(fd);
+        }
+
+        // Koneksi baru ditutup hanya setelah batch dijawab sehingga nomor fd
+        // dalam batch tidak mungkin dipakai ulang oleh accept di tengah jalan
+        if (!batch.empty()) answerBatch(batch);
+        for (int fd : touched) {
+            auto found = connections.find(fd);
+            if (found == connections.end()) continue;
+            Connection& connection = found->second;
+            if (connection.sent < connection.output.size()) flushConnection(connection);
+            if (connection.closing && connection.sent == connection.output.size()) {
+                closeConnection(fd);
+            } else {
+                updateInterest(connection);
+            }
+        }
+    }
+    closeAll();
+    return true;
+}
+
+void QueryServer::acceptConnections() {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Error: accept gagal: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+        if (connections.size() >= options.max_connections) {
+            statistics.connections_rejected++;
+            ::close(fd);
+            continue;
+        }
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        connections[fd] = Connection{fd, std::string(), std::string(), 0, EPOLLIN, false};
+        statistics.connections_accepted++;
+        statistics.open_connections = connections.size();
+    }
+}
+
+void QueryServer::readConnection(Connection& connection, std::vector<Request>& batch) {
+    if (connection.closing || connection.output.size() - connection.sent > MAX_PENDING_OUTPUT) return;
+    char buffer[READ_CHUNK];
+    size_t read_bytes = 0;
+    while (read_bytes < MAX_READ_PER_EVENT) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, static_cast<size_t>(received));
+            read_bytes += static_cast<size_t>(received);
+            continue;
+        }
+        if (received < 0 && errno == EINTR) continue;
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        // EOF atau galat: jawab permintaan yang sudah lengkap lalu tutup
+        connection.closing = true;
+        break;
+    }
+
+    Clock::time_point now = Clock::now();
+    size_t begin = 0;
+    size_t newline;
+    while ((newline = connection.input.find('\n', begin)) != std::string::npos) {
+        const char* first = connection.input.data() + begin;
+        const char* last = connection.input.data() + newline;
+        begin = newline + 1;
+        if (last > first && last[-1] == '\r') last--;
+
+        // Pecah token dengan spasi/tab tanpa alokasi
+        const char* tokens[4][2];
+        size_t token_count = 0;
+        for (const char* p = first; p < last;) {
+            while (p < last && (*p == ' ' || *p == '\t')) p++;
+            if (p == last) break;
+            const char* start = p;
+            while (p < last && *p != ' ' && *p != '\t') p++;
+            if (token_count < 4) {
+                tokens[token_count][0] = start;
+                tokens[token_count][1] = p;
+            }
+            token_count++;
+        }
+        if (token_count == 0 || *tokens[0][0] == '#') continue;
+
+        Request request = {connection.fd, QUERY_INVALID, 0.0, 0.0, 0, now};
+        std::string name(tokens[0][0], tokens[0][1]);
+        for (int type = 0; type < QUERY_INVALID; type++) {
+            if (name == QUERY_NAMES[type]) request.type = static_cast<QueryType>(type);
+        }
+        size_t arguments = 0;
+        switch (request.type) {
+            case QUERY_PREDICT:
+            case QUERY_PREDICT_UNIX:
+            case QUERY_PERCENTILE:
+                arguments = 1;
+                break;
+            case QUERY_INTEGRATE:
+            case QUERY_INTEGRATE_UNIX:
+            case QUERY_AGGREGATE:
+                arguments = 2;
+                break;
+            default:
+                break;
+        }
+        bool valid = request.type != QUERY_INVALID && token_count == arguments + 1;
+        if (valid && arguments >= 1) valid = parseNumber(tokens[1][0], tokens[1][1], request.a);
+        if (valid && arguments >= 2) valid = parseNumber(tokens[2][0], tokens[2][1], request.b);
+        if (!valid) request.type = QUERY_INVALID;
+        batch.push_back(request);
+    }
+    connection.input.erase(0, begin);
+
+    // Baris tanpa akhir yang terlalu panjang: laporkan setelah jawaban
+    // sebelumnya lalu putuskan
+    if (connection.input.size() > options.max_line) {
+        connection.input.clear();
+        batch.push_back({connection.fd, QUERY_TOO_LONG, 0.0, 0.0, 0, now});
+        connection.closing = true;
+    }
+}
+
+void QueryServer::answerBatch(std::vector<Request>& batch) {
+    // Satu snapshot untuk seluruh batch: pemuatan ulang di thread lain tidak
+    // mengubah jawaban di tengah batch
+    std::shared_ptr<const SeriesSnapshot> snapshot = analyzer.getSnapshot();
+    statistics.batches++;
+    statistics.largest_batch = std::max(statistics.largest_batch, batch.size());
+
+    std::vector<double> hours, unix_times;
+    std::vector<std::pair<double, double>> ranges;
+    for (Request& request : batch) {
+        if (request.type == QUERY_PREDICT) {
+            request.slot = hours.size();
+            hours.push_back(request.a);
+        } else if (request.type == QUERY_PREDICT_UNIX) {
+            request.slot = unix_times.size();
+            unix_times.push_back(request.a);
+        } else if (request.type == QUERY_INTEGRATE) {
+            request.slot = ranges.size();
+            ranges.push_back({request.a, request.b});
+        }
+    }
+
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> hour_values, unix_values, range_values;
+    if (!hours.empty()) hour_values = snapshot->lagrangeInterpolation(hours);
+    if (!unix_times.empty()) {
+        if (snapshot->getSeries().empty()) unix_values.assign(unix_times.size(), none);
+        else unix_values = snapshot->interpolateAt(unix_times);
+    }
+    if (!ranges.empty()) range_values = snapshot->simpsonIntegrationBatch(ranges);
+
+    for (const Request& request : batch) {
+        auto found = connections.find(request.fd);
+        if (found == connections.end()) continue;
+        double value = none;
+        if (request.type == QUERY_PREDICT) value = hour_values[request.slot];
+        else if (request.type == QUERY_PREDICT_UNIX) value = unix_values[request.slot];
+        else if (request.type == QUERY_INTEGRATE) value = range_values[request.slot];
+        answerOne(request, *snapshot, value, found->second.output);
+
+        statistics.requests++;
+        if (request.type >= QUERY_INVALID) statistics.errors++;
+        double latency = std::chrono::duration<double, std::micro>(Clock::now() - request.received).count();
+        statistics.latency_us.add(latency);
+    }
+}
+
+void QueryServer::answerOne(const Request& request, const SeriesSnapshot& snapshot, double value,
+                            std::string& out) {
+    if (request.type == QUERY_INVALID) {
+        out += "{\"error\":\"permintaan tidak valid\"}\n";
+        return;
+    }
+    if (request.type == QUERY_TOO_LONG) {
+        out += "{\"error\":\"permintaan terlalu panjang\"}\n";
+        return;
+    }
+    const double none = std::numeric_limits<double>::quiet_NaN();
+    appendQuery(out, QUERY_NAMES[request.type]);
+    switch (request.type) {
+        case QUERY_PREDICT:
+        case QUERY_PREDICT_UNIX:
+            appendField(out, "a", request.a);
+            appendField(out, "value", value);
+            break;
+        case QUERY_INTEGRATE:
+            appendField(out, "a", request.a);
+            appendField(out, "b", request.b);
+            appendField(out, "value", value);
+            break;
+        case QUERY_INTEGRATE_UNIX: {
+            // Dijawab di thread loop: rentang dibatasi ke deret dan tanpa thread
+            // tambahan agar satu permintaan lebar tidak menahan batch lebih lama
+            IntegrationResult result;
+            const TimeSeriesStore& series = snapshot.getSeries();
+            if (!series.empty()) {
+                double first = series.firstTimestamp();
+                double last = series.lastTimestamp();
+                result = snapshot.integrateSeriesAdaptive(std::min(std::max(request.a, first), last),
+                                                          std::min(std::max(request.b, first), last),
+                                                          options.tolerance, 1);
+            }
+            appendField(out, "a", request.a);
+            appendField(out, "b", request.b);
+            appendField(out, "value", result.value);
+            appendField(out, "error_estimate", result.error_estimate);
+            break;
+        }
+        case QUERY_PERCENTILE:
+            appendField(out, "a", request.a);
+            appendField(out, "value", snapshot.getPercentile(request.a));
+            break;
+        case QUERY_AGGREGATE: {
+            RangeAggregate window = snapshot.aggregateRange(request.a, request.b);
+            bool empty = window.count == 0;
+            appendField(out, "a", request.a);
+            appendField(out, "b", request.b);
+            appendField(out, "intervals", static_cast<double>(window.count));
+            appendField(out, "min_mbps", empty ? none : window.min);
+            appendField(out, "max_mbps", empty ? none : window.max);
+            appendField(out, "mean_mbps", empty ? none : window.mean());
+            appendField(out, "volume_mbps_hours", window.volume(snapshot.getIntervalDuration()));
+            appendField(out, "packets", static_cast<double>(window.packets));
+            break;
+        }
+        case QUERY_STATS: {
+            const TimeSeriesStore& series = snapshot.getSeries();
+            const TrafficStatistics& stats = snapshot.getSeriesStatistics();
+            bool empty = series.empty();
+            appendField(out, "version", static_cast<double>(snapshot.getVersion()));
+            appendField(out, "intervals", static_cast<double>(series.size()));
+            appendField(out, "interval_seconds", snapshot.getIntervalDuration());
+            appendField(out, "first_timestamp", empty ? none : series.firstTimestamp());
+            appendField(out, "last_timestamp", empty ? none : series.lastTimestamp());
+            appendField(out, "min_mbps", empty ? none : stats.min);
+            appendField(out, "max_mbps", empty ? none : stats.max);
+            appendField(out, "mean_mbps", empty ? none : stats.mean);
+            appendField(out, "stddev_mbps", empty ? none : stats.stddev);
+            appendField(out, "p50_mbps", empty ? none : snapshot.getPercentile(50));
+            appendField(out, "p95_mbps", empty ? none : snapshot.getPercentile(95));
+            appendField(out, "p99_mbps", empty ? none : snapshot.getPercentile(99));
+            break;
+        }
+        case QUERY_SERVER_STATS: {
+            const QuantileSketch& latency = statistics.latency_us;
+            appendField(out, "uptime_s", std::chrono::duration<double>(Clock::now() - started).count());
+            appendField(out, "requests", static_cast<double>(statistics.requests));
+            appendField(out, "errors", static_cast<double>(statistics.errors));
+            appendField(out, "batches", static_cast<double>(statistics.batches));
+            appendField(out, "largest_batch", static_cast<double>(statistics.largest_batch));
+            appendField(out, "connections", static_cast<double>(statistics.open_connections));
+            appendField(out, "connections_accepted", static_cast<double>(statistics.connections_accepted));
+            appendField(out, "latency_p50_us", latency.count() > 0 ? latency.quantile(0.50) : none);
+            appendField(out, "latency_p95_us", latency.count() > 0 ? latency.quantile(0.95) : none);
+            appendField(out, "latency_p99_us", latency.count() > 0 ? latency.quantile(0.99) : none);
+            break;
+        }
+        default:
+            break;
+    }
+    out += "}\n";
+}
+
+void QueryServer::flushConnection(Connection& connection) {
+    while (connection.sent < connection.output.size()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + connection.sent,
+                            connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (sent > 0) {
+            connection.sent += static_cast<size_t>(sent);
+            continue;
+        }
+        if (sent < 0 && errno == EINTR) continue;
+        // Klien lambat: sisa output tetap di buffer sampai EPOLLOUT
+        if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+        // Klien sudah pergi; buang output yang tersisa
+        connection.output.clear();
+        connection.sent = 0;
+        connection.closing = true;
+        return;
+    }
+    connection.output.clear();
+    connection.sent = 0;
+}
+
+void QueryServer::updateInterest(Connection& connection) {
+    // Picu-level: EPOLLIN hanya selama koneksi masih dibaca, EPOLLOUT hanya
+    // selama ada output tertunda, agar loop tidak berputar tanpa kerja
+    size_t pending = connection.output.size() - connection.sent;
+    uint32_t wanted = 0;
+    if (!connection.closing && pending <= MAX_PENDING_OUTPUT) wanted |= EPOLLIN;
+    if (pending > 0) wanted |= EPOLLOUT;
+    if (wanted == connection.events) return;
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = wanted;
+    event.data.fd = connection.fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &event) == 0) connection.events = wanted;
+}
+
+void QueryServer::closeConnection(int fd) {
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+    connections.erase(fd);
+    statistics.open_connections = connections.size();
+}
+
+void QueryServer::closeAll() {
+    while (!connections.empty()) closeConnection(connections.begin()->first);
+    if (listen_fd >= 0) ::close(listen_fd);
+    if (listening && !options.socket_path.empty()) {
+        // Hanya hapus soket yang dibuat proses ini; path mungkin sudah diambil alih
+        struct stat current;
+        if (lstat(options.socket_path.c_str(), &current) == 0 &&
+            static_cast<uint64_t>(current.st_dev) == socket_device &&
+            static_cast<uint64_t>(current.st_ino) == socket_inode) {
+            unlink(options.socket_path.c_str());
+        }
+    }
+    if (epoll_fd >= 0) ::close(epoll_fd);
+    if (wake_fd >= 0) ::close(wake_fd);
+    listen_fd = -1;
+    epoll_fd = -1;
+    wake_fd = -1;
+    listening = false;
+}
+
+#else // !__linux__
+
+struct QueryServer::Request {};
+
+QueryServer::QueryServer(const NetworkAnalyzer& analyzer, const ServerOptions& options)
+    : analyzer(analyzer), options(options), listen_fd(-1), epoll_fd(-1), wake_fd(-1), listening(false),
+      socket_device(0), socket_inode(0) {}
+
+QueryServer::~QueryServer() {}
+
+bool QueryServer::start() {
+    std::cerr << "Error: Mode server membutuhkan epoll dan hanya tersedia di Linux." << std::endl;
+    return false;
+}
+
+bool QueryServer::run() {
+    return false;
+}
+
+void QueryServer::stop() {}
+
+int QueryServer::getPort() const {
+    return -1;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "quantile_sketch.h"
+
+class NetworkAnalyzer;
+class SeriesSnapshot;
+
+struct ServerOptions {
+    std::string socket_path;       // Soket domain Unix; kosong = TCP
+    int port = -1;                 // Port TCP pada 127.0.0.1 bila socket_path kosong (0 = acak)
+    double tolerance = 1e-6;       // Galat absolut integrate-unix (Mbps×jam)
+    size_t max_connections = 1024;
+    size_t max_line = 4096;        // Permintaan lebih panjang menutup koneksi
+};
+
+// Penghitung server; latensi diukur dari data permintaan selesai dibaca
+// sampai jawabannya masuk buffer keluaran koneksi
+struct ServerStatistics {
+    uint64_t requests = 0;
+    uint64_t errors = 0;            // Permintaan tidak valid
+    uint64_t batches = 0;           // Satu batch per bangun dari epoll_wait
+    size_t largest_batch = 0;
+    uint64_t connections_accepted = 0;
+    uint64_t connections_rejected = 0;
+    size_t open_connections = 0;
+    QuantileSketch latency_us;
+};
+
+// Daemon kueri lokal: data dimuat sekali ke analyzer dan tetap panas di
+// memori, lalu permintaan satu baris per kueri dilayani lewat soket domain
+// Unix atau TCP localhost dengan satu loop epoll (Linux).
+//
+// Protokol (satu permintaan per baris, jawaban satu objek JSON per baris
+// dengan urutan yang sama per koneksi):
+//   predict <jam>                       predict-unix <timestamp>
+//   integrate <jam_awal> <jam_akhir>    integrate-unix <ts_awal> <ts_akhir>  (dibatasi ke deret)
+//   percentile <p>                      aggregate <ts_awal> <ts_akhir>
+//   stats    server-stats    ping
+//
+// Semua baris lengkap dari semua koneksi yang siap pada satu bangun
+// dijawab sebagai satu batch atas satu snapshot: predict, predict-unix, dan
+// integrate dikelompokkan ke API batch analyzer seperti query-file.
+class QueryServer {
+private:
+    struct Connection {
+        int fd;
+        std::string input;
+        std::string output;
+        size_t sent;            // Byte output yang sudah terkirim
+        uint32_t events;        // Kejadian epoll yang sedang didaftarkan
+        bool closing;           // Tutup setelah output terkirim
+    };
+    struct Request;
+
+    const NetworkAnalyzer& analyzer;
+    ServerOptions options;
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;                // eventfd untuk stop()
+    bool listening;
+    uint64_t socket_device;     // dev/ino soket Unix yang dibuat proses ini
+    uint64_t socket_inode;
+    std::unordered_map<int, Connection> connections;
+    ServerStatistics statistics;
+    std::chrono::steady_clock::time_point started;
+
+    void acceptConnections();
+    void readConnection(Connection& connection, std::vector<Request>& batch);
+    void answerBatch(std::vector<Request>& batch);
+    void answerOne(const Request& request, const SeriesSnapshot& snapshot, double value, std::string& out);
+    void flushConnection(Connection& connection);
+    void closeConnection(int fd);
+    void updateInterest(Connection& connection);
+    void closeAll();
+
+public:
+    QueryServer(const NetworkAnalyzer& analyzer, const ServerOptions& options);
+    ~QueryServer();
+
+    QueryServer(const QueryServer&) = delete;
+    QueryServer& operator=(const QueryServer&) = delete;
+
+    bool start();     // Buat soket dan mulai mendengarkan
+    bool run();       // Layani sampai stop(); false jika loop gagal
+    void stop();      // Aman dipanggil dari penangan sinyal atau thread lain
+
+    int getPort() const;   // Port TCP yang benar-benar dipakai; -1 untuk soket Unix
+    const ServerStatistics& getStatistics() const { return statistics; }
+};
+
+#endif // QUERY_SERVER_H
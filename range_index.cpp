@@ -0,0 +1,196 @@
+#include "range_index.h"
+#include <algorithm>
+#include <cmath>
+
+void RangeAggregate::add(double bandwidth_mbps, long long packet_count) {
+    if (count == 0) {
+        min = bandwidth_mbps;
+        max = bandwidth_mbps;
+    } else {
+        min = std::min(min, bandwidth_mbps);
+        max = std::max(max, bandwidth_mbps);
+    }
+    count++;
+    sum += bandwidth_mbps;
+    packets += packet_count;
+}
+
+void RangeAggregate::merge(const RangeAggregate& other) {
+    if (other.count == 0) return;
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+    count += other.count;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    sum += other.sum;
+    packets += other.packets;
+}
+
+static RangeAggregate combine(const RangeAggregate& a, const RangeAggregate& b) {
+    RangeAggregate result = a;
+    result.merge(b);
+    return result;
+}
+
+void SegmentTree::grow() {
+    size_t new_capacity = capacity == 0 ? 1 : capacity * 2;
+    std::vector<RangeAggregate> grown(2 * new_capacity);
+    std::copy(nodes.begin() + capacity, nodes.begin() + capacity + count, grown.begin() + new_capacity);
+    for (size_t i = new_capacity - 1; i >= 1; i--) {
+        grown[i] = combine(grown[2 * i], grown[2 * i + 1]);
+    }
+    nodes.swap(grown);
+    capacity = new_capacity;
+}
+
+void SegmentTree::refresh(size_t leaf) {
+    for (size_t i = (capacity + leaf) / 2; i >= 1; i /= 2) {
+        nodes[i] = combine(nodes[2 * i], nodes[2 * i + 1]);
+    }
+}
+
+void SegmentTree::append(const RangeAggregate& leaf) {
+    if (count == capacity) grow();
+    nodes[capacity + count] = leaf;
+    refresh(count);
+    count++;
+}
+
+void SegmentTree::set(size_t index, const RangeAggregate& leaf) {
+    nodes[capacity + index] = leaf;
+    refresh(index);
+}
+
+void SegmentTree::clear() {
+    nodes.clear();
+    capacity = 0;
+    count = 0;
+}
+
+RangeAggregate SegmentTree::query(size_t first, size_t last) const {
+    RangeAggregate result;
+    if (first > last || last >= count) return result;
+    // Rentang setengah terbuka [lo, hi) di tingkat daun, naik satu tingkat per iterasi
+    for (size_t lo = first + capacity, hi = last + 1 + capacity; lo < hi; lo /= 2, hi /= 2) {
+        if (lo & 1) result.merge(nodes[lo++]);
+        if (hi & 1) result.merge(nodes[--hi]);
+    }
+    return result;
+}
+
+const char* rollupLevelName(RollupLevel level) {
+    switch (level) {
+        case ROLLUP_5MIN: return "5m";
+        case ROLLUP_HOUR: return "1h";
+        case ROLLUP_DAY: return "1d";
+        default: return "unknown";
+    }
+}
+
+double rollupWidth(RollupLevel level) {
+    switch (level) {
+        case ROLLUP_5MIN: return 300.0;
+        case ROLLUP_HOUR: return 3600.0;
+        default: return 86400.0;
+    }
+}
+
+bool parseRollupLevel(const std::string& name, RollupLevel& level) {
+    for (int l = 0; l < ROLLUP_LEVEL_COUNT; l++) {
+        if (name == rollupLevelName(static_cast<RollupLevel>(l))) {
+            level = static_cast<RollupLevel>(l);
+            return true;
+        }
+    }
+    return false;
+}
+
+void RollupSeries::add(double timestamp, double bandwidth_mbps, long long packet_count) {
+    double start = std::floor(timestamp / width) * width;
+    size_t index;
+    if (bucket_starts.empty() || start > bucket_starts.back()) {
+        bucket_starts.push_back(start);
+        tree.append(RangeAggregate());
+        index = bucket_starts.size() - 1;
+    } else {
+        // Interval yang datang tidak berurutan hanya masuk ke ember yang sudah ada
+        auto found = std::lower_bound(bucket_starts.begin(), bucket_starts.end(), start);
+        if (found == bucket_starts.end() || *found != start) return;
+        index = static_cast<size_t>(found - bucket_starts.begin());
+    }
+    RangeAggregate bucket = tree.leaf(index);
+    bucket.add(bandwidth_mbps, packet_count);
+    tree.set(index, bucket);
+}
+
+void RollupSeries::clear() {
+    bucket_starts.clear();
+    tree.clear();
+}
+
+RangeAggregate RollupSeries::aggregate(double start_unix, double end_unix) const {
+    size_t first = static_cast<size_t>(
+        std::lower_bound(bucket_starts.begin(), bucket_starts.end(), start_unix) - bucket_starts.begin());
+    size_t end = static_cast<size_t>(
+        std::lower_bound(bucket_starts.begin(), bucket_starts.end(), end_unix) - bucket_starts.begin());
+    if (first >= end) return RangeAggregate();
+    return tree.query(first, end - 1);
+}
+
+RangeIndex::RangeIndex() {
+    for (int l = 0; l < ROLLUP_LEVEL_COUNT; l++) {
+        rollups[l] = RollupSeries(rollupWidth(static_cast<RollupLevel>(l)));
+    }
+}
+
+void RangeIndex::add(const TimeSeriesStore& series) {
+    size_t index = series.size() - 1;
+    double bandwidth = series.bandwidthAt(index);
+    long long packets = series.packetsAt(index);
+
+    size_t block = index / BLOCK_SIZE;
+    if (block == blocks.size()) blocks.append(RangeAggregate());
+    RangeAggregate summary = blocks.leaf(block);
+    summary.add(bandwidth, packets);
+    blocks.set(block, summary);
+
+    for (RollupSeries& rollup : rollups) {
+        rollup.add(series.timestampAt(index), bandwidth, packets);
+    }
+}
+
+void RangeIndex::clear() {
+    blocks.clear();
+    for (RollupSeries& rollup : rollups) rollup.clear();
+}
+
+RangeAggregate RangeIndex::scan(const TimeSeriesStore& series, size_t first, size_t last) {
+    RangeAggregate result;
+    const double* bandwidth = series.bandwidth();
+    const int64_t* packets = series.packets();
+    for (size_t i = first; i <= last; i++) result.add(bandwidth[i], packets[i]);
+    return result;
+}
+
+RangeAggregate RangeIndex::aggregate(const TimeSeriesStore& series, size_t first, size_t last) const {
+    size_t n = series.size();
+    if (first > last || last >= n) return RangeAggregate();
+
+    size_t first_block = first / BLOCK_SIZE;
+    size_t last_block = last / BLOCK_SIZE;
+    if (last_block - first_block < 2) return scan(series, first, last);
+
+    // Blok yang tercakup penuh dijawab pohon; sisanya dipindai dari kolom.
+    // Blok terakhir deret boleh belum penuh.
+    size_t full_first = first % BLOCK_SIZE == 0 ? first_block : first_block + 1;
+    size_t last_block_end = std::min((last_block + 1) * BLOCK_SIZE, n);
+    size_t full_end = last + 1 == last_block_end ? last_block + 1 : last_block;
+
+    RangeAggregate result;
+    if (first < full_first * BLOCK_SIZE) result.merge(scan(series, first, full_first * BLOCK_SIZE - 1));
+    result.merge(blocks.query(full_first, full_end - 1));
+    if (full_end * BLOCK_SIZE <= last) result.merge(scan(series, full_end * BLOCK_SIZE, last));
+    return result;
+}
@@ -0,0 +1,115 @@
+#ifndef RANGE_INDEX_H
+#define RANGE_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "time_series_store.h"
+
+// Ringkasan sekumpulan interval; dapat digabung dalam urutan apa pun
+struct RangeAggregate {
+    size_t count = 0;          // Jumlah interval
+    double min = 0.0;          // Bandwidth interval terendah (Mbps)
+    double max = 0.0;          // Bandwidth interval tertinggi (Mbps)
+    double sum = 0.0;          // Jumlah bandwidth interval (Mbps)
+    long long packets = 0;
+
+    void add(double bandwidth_mbps, long long packet_count);
+    void merge(const RangeAggregate& other);
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    // Volume dalam Mbps×jam, sama dengan integral deret per interval
+    double volume(double interval_duration) const { return sum * interval_duration / 3600.0; }
+};
+
+// Pohon segmen iteratif atas ringkasan yang hanya bertambah di ujung.
+// Kapasitas digandakan (dibangun ulang) bila penuh sehingga append
+// diamortisasi O(1) ditambah O(log n) untuk memperbarui jalur ke akar.
+class SegmentTree {
+private:
+    std::vector<RangeAggregate> nodes;   // nodes[capacity + i] = daun i
+    size_t capacity;
+    size_t count;
+
+    void grow();
+    void refresh(size_t leaf);
+
+public:
+    SegmentTree() : capacity(0), count(0) {}
+
+    void append(const RangeAggregate& leaf);
+    void set(size_t index, const RangeAggregate& leaf);   // Ganti daun, O(log n)
+    void clear();
+
+    size_t size() const { return count; }
+    const RangeAggregate& leaf(size_t index) const { return nodes[capacity + index]; }
+    RangeAggregate query(size_t first, size_t last) const;   // Daun [first, last], O(log n)
+};
+
+enum RollupLevel {
+    ROLLUP_5MIN,
+    ROLLUP_HOUR,
+    ROLLUP_DAY,
+    ROLLUP_LEVEL_COUNT
+};
+
+const char* rollupLevelName(RollupLevel level);   // "5m", "1h", "1d"
+double rollupWidth(RollupLevel level);            // Lebar ember dalam detik
+bool parseRollupLevel(const std::string& name, RollupLevel& level);
+
+// Deret ember dengan lebar tetap yang diselaraskan ke epoch Unix (UTC).
+// Ember terakhir yang masih terbuka diperbarui di tempat setiap interval.
+class RollupSeries {
+private:
+    double width;
+    std::vector<double> bucket_starts;
+    SegmentTree tree;
+
+public:
+    explicit RollupSeries(double width = 300.0) : width(width) {}
+
+    void add(double timestamp, double bandwidth_mbps, long long packet_count);
+    void clear();
+
+    double getWidth() const { return width; }
+    size_t size() const { return bucket_starts.size(); }
+    double bucketStart(size_t index) const { return bucket_starts[index]; }
+    const RangeAggregate& bucket(size_t index) const { return tree.leaf(index); }
+    RangeAggregate aggregate(double start_unix, double end_unix) const;   // Ember yang dimulai dalam [start, end)
+};
+
+// Indeks agregat rentang atas deret interval, diperbarui setiap interval
+// baru. Interval dikelompokkan dalam blok BLOCK_SIZE dan pohon segmen
+// dibangun atas ringkasan blok, sehingga kueri memindai paling banyak dua
+// blok parsial dari kolom deret ditambah O(log n) simpul pohon. Pohon blok
+// sendiri hanya 5-10 byte per interval (simpul 40 byte, 2-4 simpul per blok).
+//
+// Rollup 5 menit, 1 jam, dan 1 hari dipelihara bersamaan; karena
+// ringkasan dapat digabung, setiap tingkat sama dengan menggabungkan
+// tingkat di bawahnya. Setiap ember rollup memakan sekitar 90-180 byte
+// (awal ember ditambah 2-4 simpul pohon), sehingga dengan interval bawaan
+// 300 detik rollup 5 menit (satu ember per interval) mendominasi dan total
+// indeks sekitar 100-200 byte per interval.
+class RangeIndex {
+public:
+    static const size_t BLOCK_SIZE = 16;
+
+private:
+    SegmentTree blocks;
+    RollupSeries rollups[ROLLUP_LEVEL_COUNT];
+
+    static RangeAggregate scan(const TimeSeriesStore& series, size_t first, size_t last);
+
+public:
+    RangeIndex();
+
+    // Indeks interval terakhir series; panggil setelah setiap append
+    void add(const TimeSeriesStore& series);
+    void clear();
+
+    // Interval berindeks [first, last] dari series yang sama
+    RangeAggregate aggregate(const TimeSeriesStore& series, size_t first, size_t last) const;
+    const RollupSeries& getRollup(RollupLevel level) const { return rollups[level]; }
+};
+
+#endif // RANGE_INDEX_H
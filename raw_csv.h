@@ -0,0 +1,172 @@
+#ifndef RAW_CSV_H
+#define RAW_CSV_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define RAW_CSV_USE_SSE2 1
+#endif
+
+// Pemindai CSV mentah (Timestamp,Source IP,Destination IP,Protocol,Length)
+// yang bekerja langsung di atas buffer (misalnya hasil mmap). Kolom yang
+// tidak dipakai hanya dilewati, tidak pernah disalin ke std::string.
+namespace raw_csv {
+
+// Cari ',' atau '\n' berikutnya mulai dari p; kembalikan end jika tidak ada
+inline const char* nextDelimiter(const char* p, const char* end) {
+#ifdef RAW_CSV_USE_SSE2
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i newline = _mm_set1_epi8('\n');
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(block, comma),
+                                    _mm_cmpeq_epi8(block, newline));
+        int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) return p + __builtin_ctz(static_cast<unsigned>(mask));
+        p += 16;
+    }
+#endif
+    while (p < end && *p != ',' && *p != '\n') ++p;
+    return p;
+}
+
+// Cari awal baris berikutnya (setelah '\n'); kembalikan end jika tidak ada
+inline const char* nextLine(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+// Buang tanda kutip dan '\r' di tepi field, seperti pada ekspor Wireshark
+inline void trimField(const char*& first, const char*& last) {
+    while (last > first && (last[-1] == '\r' || last[-1] == ' ')) --last;
+    if (last - first >= 2 && *first == '"' && last[-1] == '"') {
+        ++first;
+        --last;
+    }
+}
+
+// Statistik hasil pemindaian
+struct ScanResult {
+    size_t rows = 0;          // Baris data yang berhasil diurai
+    size_t skipped_rows = 0;  // Baris rusak atau tanpa panjang paket
+};
+
+// Potongan teks di dalam buffer (tanpa salinan)
+struct Field {
+    const char* data = nullptr;
+    size_t size = 0;
+};
+
+// Satu baris paket yang valid. Kolom teks hanya berupa penunjuk ke buffer
+// dan baru disentuh jika pemanggil membutuhkannya (mode aliran).
+struct Row {
+    double timestamp = 0.0;
+    int length = 0;
+    Field source;
+    Field destination;
+    Field protocol;
+};
+
+// Pindai semua baris lengkap dalam [begin, end). Untuk setiap paket valid,
+// on_row(row) dipanggil. Header harus sudah dilewati.
+template <typename Callback>
+ScanResult scanRows(const char* begin, const char* end, Callback&& on_row) {
+    ScanResult result;
+    const char* p = begin;
+    Row row;
+
+    while (p < end) {
+        const char* line_start = p;
+
+        // Kolom 1: Timestamp
+        const char* delim = nextDelimiter(p, end);
+        const char* first = p;
+        const char* last = delim;
+        trimField(first, last);
+
+        auto ts_parse = std::from_chars(first, last, row.timestamp);
+        bool valid = ts_parse.ec == std::errc() && delim < end && *delim == ',';
+
+        // Kolom 2-4: Source IP, Dest IP, Protocol (hanya dicatat posisinya)
+        Field* text_fields[3] = {&row.source, &row.destination, &row.protocol};
+        for (int column = 0; valid && column < 3; column++) {
+            const char* field_start = delim + 1;
+            delim = nextDelimiter(field_start, end);
+            valid = delim < end && *delim == ',';
+            text_fields[column]->data = field_start;
+            text_fields[column]->size = static_cast<size_t>(delim - field_start);
+        }
+
+        // Kolom 5: Length
+        if (valid) {
+            const char* field_start = delim + 1;
+            delim = nextDelimiter(field_start, end);
+            first = field_start;
+            last = delim;
+            trimField(first, last);
+            valid = first < last &&
+                    std::from_chars(first, last, row.length).ec == std::errc();
+        }
+
+        if (valid) {
+            on_row(row);
+            result.rows++;
+        } else if (delim > line_start) {
+            result.skipped_rows++;
+        }
+
+        // Lanjut ke baris berikutnya (kolom tambahan diabaikan)
+        p = (delim < end && *delim == '\n') ? delim + 1 : nextLine(delim, end);
+    }
+
+    return result;
+}
+
+// Seperti scanRows, tetapi hanya meneruskan on_packet(timestamp, length)
+template <typename Callback>
+ScanResult scan(const char* begin, const char* end, Callback&& on_packet) {
+    return scanRows(begin, end, [&on_packet](const Row& row) {
+        on_packet(row.timestamp, row.length);
+    });
+}
+
+// Timestamp paket valid pertama dalam [begin, end)
+inline bool firstTimestamp(const char* begin, const char* end, double& timestamp) {
+    bool found = false;
+    for (const char* line = begin; line < end && !found;) {
+        const char* next = nextLine(line, end);
+        scan(line, next, [&](double ts, int) {
+            timestamp = ts;
+            found = true;
+        });
+        line = next;
+    }
+    return found;
+}
+
+// Timestamp paket valid terakhir dalam [begin, end), dicari dari belakang.
+// Hanya beberapa baris terakhir yang diperiksa agar tetap O(1).
+inline bool lastTimestamp(const char* begin, const char* end, double& timestamp) {
+    const char* line_end = end;
+    for (int attempt = 0; attempt < 64 && line_end > begin; attempt++) {
+        const char* line_start = line_end;
+        if (line_start > begin && line_start[-1] == '\n') --line_start;
+        while (line_start > begin && line_start[-1] != '\n') --line_start;
+
+        bool found = false;
+        scan(line_start, line_end, [&](double ts, int) {
+            timestamp = ts;
+            found = true;
+        });
+        if (found) return true;
+        line_end = line_start;
+    }
+    return false;
+}
+
+} // namespace raw_csv
+
+#endif // RAW_CSV_H
@@ -0,0 +1,126 @@
+#include "seasonal_forecaster.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+const double SECONDS_PER_DAY = 86400.0;
+const double SECONDS_PER_WEEK = 7.0 * SECONDS_PER_DAY;
+
+namespace {
+
+size_t slotCount(double period, double interval_duration) {
+    return static_cast<size_t>(std::ceil(period / interval_duration));
+}
+
+double phaseOf(double unix_time, double period) {
+    double phase = std::fmod(unix_time, period);
+    return phase < 0 ? phase + period : phase;
+}
+
+} // namespace
+
+SeasonalForecaster::SeasonalForecaster(double interval_duration, const ForecastParameters& parameters)
+    : parameters(parameters), interval_duration(interval_duration),
+      daily(slotCount(SECONDS_PER_DAY, interval_duration), std::numeric_limits<double>::quiet_NaN()),
+      weekly(slotCount(SECONDS_PER_WEEK, interval_duration), 0.0),
+      level(0.0), trend(0.0), first_timestamp(0.0), last_timestamp(0.0), observations(0),
+      normalized(false), scored(0), absolute_error_sum(0.0), squared_error_sum(0.0) {}
+
+size_t SeasonalForecaster::dailySlot(double unix_time) const {
+    size_t slot = static_cast<size_t>(phaseOf(unix_time, SECONDS_PER_DAY) / interval_duration);
+    return std::min(slot, daily.size() - 1);
+}
+
+size_t SeasonalForecaster::weeklySlot(double unix_time) const {
+    size_t slot = static_cast<size_t>(phaseOf(unix_time, SECONDS_PER_WEEK) / interval_duration);
+    return std::min(slot, weekly.size() - 1);
+}
+
+double SeasonalForecaster::dampedSum(double steps) const {
+    double phi = parameters.phi;
+    if (steps <= 0) return 0.0;
+    if (phi >= 1.0) return steps;
+    return phi * (1.0 - std::pow(phi, steps)) / (1.0 - phi);
+}
+
+void SeasonalForecaster::update(double timestamp, double value) {
+    const ForecastParameters& p = parameters;
+    size_t d = dailySlot(timestamp);
+    size_t w = weeklySlot(timestamp);
+
+    if (observations == 0) {
+        level = value;
+        trend = 0.0;
+        first_timestamp = timestamp;
+        daily[d] = 0.0;
+        last_timestamp = timestamp;
+        observations = 1;
+        return;
+    }
+
+    // Proyeksikan level melewati interval kosong di antara dua pengamatan
+    double steps = std::max(1.0, std::round((timestamp - last_timestamp) / interval_duration));
+    double previous_level = level + dampedSum(steps) * trend;
+    double previous_trend = trend * std::pow(p.phi, steps);
+
+    double& seasonal_day = daily[d];
+    double& seasonal_week = weekly[w];
+    if (std::isnan(seasonal_day)) {
+        // Slot pertama kali terlihat: selisihnya langsung menjadi musiman harian
+        seasonal_day = value - previous_level - seasonal_week;
+    } else {
+        double error = value - (previous_level + seasonal_day + seasonal_week);
+        absolute_error_sum += std::fabs(error);
+        squared_error_sum += error * error;
+        scored++;
+    }
+
+    level = p.alpha * (value - seasonal_day - seasonal_week) + (1.0 - p.alpha) * previous_level;
+    trend = p.beta * (level - (previous_level - previous_trend)) + (1.0 - p.beta) * previous_trend;
+    double new_day = p.gamma * (value - level - seasonal_week) + (1.0 - p.gamma) * seasonal_day;
+    double new_week = p.omega * (value - level - seasonal_day) + (1.0 - p.omega) * seasonal_week;
+    seasonal_day = new_day;
+    seasonal_week = new_week;
+
+    last_timestamp = timestamp;
+    observations++;
+
+    // Sekali setelah hari pertama: pusatkan musiman harian ke rata-rata nol.
+    // Ramalan tidak berubah karena selisihnya dipindahkan ke level.
+    if (!normalized && timestamp - first_timestamp >= SECONDS_PER_DAY) {
+        double sum = 0.0;
+        size_t seen = 0;
+        for (double seasonal : daily) {
+            if (std::isnan(seasonal)) continue;
+            sum += seasonal;
+            seen++;
+        }
+        double shift = seen > 0 ? sum / seen : 0.0;
+        for (double& seasonal : daily) {
+            if (!std::isnan(seasonal)) seasonal -= shift;
+        }
+        level += shift;
+        normalized = true;
+    }
+}
+
+double SeasonalForecaster::forecast(double unix_time) const {
+    if (observations == 0) return 0.0;
+    double seasonal_day = daily[dailySlot(unix_time)];
+    if (std::isnan(seasonal_day)) seasonal_day = 0.0;
+    double steps = (unix_time - last_timestamp) / interval_duration;
+    double value = level + dampedSum(steps) * trend + seasonal_day + weekly[weeklySlot(unix_time)];
+    return std::max(0.0, value);
+}
+
+bool SeasonalForecaster::hasSeasonalHistory(double unix_time) const {
+    return observations > 0 && !std::isnan(daily[dailySlot(unix_time)]);
+}
+
+double SeasonalForecaster::getMeanAbsoluteError() const {
+    return scored > 0 ? absolute_error_sum / scored : std::numeric_limits<double>::quiet_NaN();
+}
+
+double SeasonalForecaster::getRootMeanSquaredError() const {
+    return scored > 0 ? std::sqrt(squared_error_sum / scored) : std::numeric_limits<double>::quiet_NaN();
+}
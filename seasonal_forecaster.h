@@ -0,0 +1,70 @@
+#ifndef SEASONAL_FORECASTER_H
+#define SEASONAL_FORECASTER_H
+
+#include <cstddef>
+#include <vector>
+
+// Konstanta pemulusan Holt-Winters
+struct ForecastParameters {
+    double alpha = 0.10;   // Level
+    double beta = 0.01;    // Tren
+    double gamma = 0.20;   // Musiman harian
+    double omega = 0.10;   // Musiman mingguan
+    double phi = 0.98;     // Redaman tren; 1 = tren linear tanpa redaman
+};
+
+// Holt-Winters aditif dengan tren teredam dan dua musiman (harian dan
+// mingguan, Taylor 2003). Fase musiman diambil dari timestamp Unix (UTC),
+// bukan dari urutan data, sehingga celah dalam deret tidak menggeser pola.
+//
+// Setiap interval baru diproses dalam O(1) tanpa menyesuaikan ulang model,
+// dan hasilnya deterministik untuk deret yang sama. Slot musiman yang belum
+// pernah terlihat diinisialisasi dari pengamatan pertamanya.
+class SeasonalForecaster {
+public:
+    explicit SeasonalForecaster(double interval_duration = 300.0,
+                                const ForecastParameters& parameters = ForecastParameters());
+
+    // Tambahkan satu interval; timestamp harus naik
+    void update(double timestamp, double value);
+
+    // Ramalan pada timestamp Unix mana pun (tidak negatif). Setelah interval
+    // terakhir tren teredam ikut diproyeksikan; sebelumnya hanya level dan musiman.
+    double forecast(double unix_time) const;
+
+    bool empty() const { return observations == 0; }
+    bool hasSeasonalHistory(double unix_time) const;   // Slot harian unix_time sudah pernah terlihat
+    size_t getObservationCount() const { return observations; }
+    double getLevel() const { return level; }
+    double getTrend() const { return trend; }
+    double getLastTimestamp() const { return last_timestamp; }
+    const ForecastParameters& getParameters() const { return parameters; }
+
+    // Galat ramalan satu langkah ke depan atas interval yang sudah dinilai
+    // (mulai hari kedua); NaN selama getScoredCount() masih 0
+    double getMeanAbsoluteError() const;
+    double getRootMeanSquaredError() const;
+    size_t getScoredCount() const { return scored; }
+
+private:
+    ForecastParameters parameters;
+    double interval_duration;
+    std::vector<double> daily;    // Satu slot per interval dalam sehari; NaN = belum terlihat
+    std::vector<double> weekly;   // Satu slot per interval dalam seminggu
+    double level;
+    double trend;
+    double first_timestamp;
+    double last_timestamp;
+    size_t observations;
+    bool normalized;              // Musiman harian sudah dipusatkan setelah hari pertama
+
+    size_t scored;                // Interval yang ikut dihitung galatnya
+    double absolute_error_sum;
+    double squared_error_sum;
+
+    size_t dailySlot(double unix_time) const;
+    size_t weeklySlot(double unix_time) const;
+    double dampedSum(double steps) const;   // phi + phi^2 + ... + phi^steps
+};
+
+#endif // SEASONAL_FORECASTER_H
@@ -0,0 +1,67 @@
+#ifndef SERIES_FILE_H
+#define SERIES_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Format biner kolumnar untuk data terproses (.bin).
+//
+// Tata letak file (little-endian):
+//   [Header 128 byte]
+//   [kolom timestamp      : double  x interval_count]
+//   [kolom bandwidth_mbps : double  x interval_count]
+//   [kolom packet_count   : int64   x interval_count]
+//   [kolom jam (0-24)     : double  x hourly_count]
+//   [kolom bandwidth jam  : double  x hourly_count]
+// Setiap kolom dimulai pada offset kelipatan 64 byte sehingga dapat dibaca
+// langsung dari hasil mmap tanpa penguraian; pemuat menolak offset yang
+// bukan kelipatan 8 agar tidak pernah membaca double/int64 yang tidak selaras.
+//
+// File hanya menyimpan deret, bukan keadaan turunannya. Pemuat tetap
+// memutar ulang setiap interval lewat recordInterval untuk membangun ulang
+// sketsa persentil, model Holt-Winters, detektor anomali, dan indeks
+// rentang, sehingga startup tetap O(n) kerja model (tanpa penguraian teks
+// maupun agregasi paket). Menyimpan keadaan itu akan mengikat format ke
+// representasi internal setiap model dan membuatnya basi bila parameternya
+// berubah.
+namespace series_file {
+
+const char MAGIC[8] = {'N', 'A', 'S', 'E', 'R', 'I', 'E', 'S'};
+const uint32_t VERSION = 1;
+const uint32_t ENDIAN_MARK = 0x01020304;
+const size_t COLUMN_ALIGNMENT = 64;
+
+enum Column {
+    COL_TIMESTAMP = 0,
+    COL_BANDWIDTH,
+    COL_PACKETS,
+    COL_HOUR,
+    COL_HOUR_BANDWIDTH,
+    COLUMN_COUNT
+};
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t endian_mark;
+    uint64_t interval_count;
+    uint64_t hourly_count;
+    double interval_duration;
+    uint64_t column_offset[COLUMN_COUNT];
+    uint32_t column_crc[COLUMN_COUNT];
+    uint32_t header_crc;        // CRC dari semua byte header sebelum field ini
+    uint8_t reserved[128 - 8 - 4 - 4 - 8 - 8 - 8 - 8 * COLUMN_COUNT - 4 * COLUMN_COUNT - 4];
+};
+
+static_assert(sizeof(Header) == 128, "Header format biner harus 128 byte");
+
+// CRC-32 (polinomial IEEE 802.3), dapat dilanjutkan dengan seed sebelumnya
+uint32_t crc32(const void* data, size_t size, uint32_t seed = 0);
+
+inline size_t alignUp(size_t offset) {
+    return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+} // namespace series_file
+
+#endif // SERIES_FILE_H
@@ -0,0 +1,399 @@
+#include "series_snapshot.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// Integrasi adaptif deret penuh: rentang dipotong menjadi potongan berisi
+// paling banyak SERIES_SAMPLES_PER_PIECE interval, dan rentang yang lebih
+// panjang dari PARALLEL_INTEGRATION_SECONDS dikerjakan oleh beberapa thread
+const double SERIES_SAMPLES_PER_PIECE = 16.0;
+const size_t MAX_SERIES_PIECES = 1 << 20;
+const double PARALLEL_INTEGRATION_SECONDS = 86400.0;
+
+SeriesSnapshot::SeriesSnapshot(double interval_duration, int lagrange_degree, int series_degree)
+    : interval_duration(interval_duration), lagrange_degree(lagrange_degree),
+      series_degree(series_degree), version(0), forecaster(interval_duration) {}
+
+void SeriesSnapshot::recordInterval(const TrafficData& point) {
+    series.append(point);
+    range_index.add(series);
+    
+    // Perbarui sketsa kuantil secara inkremental
+    series_sketch.add(point.bandwidth_mbps);
+    double seconds_of_day = std::fmod(point.timestamp, 86400.0);
+    if (seconds_of_day < 0) seconds_of_day += 86400.0;
+    int hour = std::min(23, static_cast<int>(seconds_of_day / 3600.0));
+    hour_of_day_sketches[hour].add(point.bandwidth_mbps);
+    
+    // Interval dinilai terhadap ramalan sebelum model belajar darinya; slot
+    // harian yang belum pernah terlihat (hari pertama) belum punya nilai harapan
+    double learned = point.bandwidth_mbps;
+    if (forecaster.hasSeasonalHistory(point.timestamp)) {
+        anomaly_detector.observe(point.timestamp, point.bandwidth_mbps,
+                                 forecaster.forecast(point.timestamp));
+        learned = anomaly_detector.getCleanValue();
+    }
+    forecaster.update(point.timestamp, learned);
+}
+
+void SeriesSnapshot::buildForecastTable() {
+    hourly.clear();
+    if (forecaster.empty()) return;
+    
+    // Jam h adalah kemunculan berikutnya pukul h:00 UTC setelah interval terakhir;
+    // nilainya rata-rata ramalan pada setiap awal interval dalam jam tersebut
+    double next_interval = forecaster.getLastTimestamp() + interval_duration;
+    double day_start = std::floor(next_interval / 86400.0) * 86400.0;
+    int samples = std::max(1, static_cast<int>(std::lround(3600.0 / interval_duration)));
+    for (int hour = 0; hour < 24; hour++) {
+        double hour_start = day_start + hour * 3600.0;
+        if (hour_start + 3600.0 <= next_interval) hour_start += 86400.0;
+        double sum = 0.0;
+        for (int i = 0; i < samples; i++) {
+            sum += forecaster.forecast(hour_start + i * interval_duration);
+        }
+        hourly.append(hour, sum / samples);
+    }
+    rebuildNumericIndex();
+}
+
+void SeriesSnapshot::computeSeriesStatistics() {
+    NA_METRIC_STAGE(STAGE_STATISTICS);
+    series_statistics = computeTrafficStatistics(series.bandwidth(), series.size());
+}
+
+double SeriesSnapshot::lagrangeInterpolation(double target_time) const {
+    if (interpolator.empty()) {
+        std::cerr << "Error: Tidak ada data tersedia untuk interpolasi." << std::endl;
+        return 0.0;
+    }
+    
+    // Satu titik dievaluasi langsung, tanpa alokasi vektor maupun pengukur waktu
+    NA_METRIC_COUNT(INTERPOLATION_QUERIES, 1);
+    double clamped = std::min(std::max(target_time, hourly.firstTimestamp()), hourly.lastTimestamp());
+    return std::max(0.0, interpolator.evaluate(clamped));
+}
+
+std::vector<double> SeriesSnapshot::lagrangeInterpolation(const std::vector<double>& target_times) const {
+    NA_METRIC_QUERY(STAGE_INTERPOLATION);
+    NA_METRIC_COUNT(INTERPOLATION_QUERIES, target_times.size());
+    std::vector<double> results(target_times.size(), 0.0);
+    if (interpolator.empty()) return results;
+    
+    // Batasi target_time ke rentang data yang tersedia
+    double lo = hourly.firstTimestamp();
+    double hi = hourly.lastTimestamp();
+    std::vector<double> clamped(target_times.size());
+    for (size_t i = 0; i < target_times.size(); i++) {
+        clamped[i] = std::min(std::max(target_times[i], lo), hi);
+    }
+    
+    interpolator.evaluate(clamped.data(), results.data(), clamped.size());
+    
+    // Bandwidth tidak mungkin negatif
+    for (double& result : results) {
+        if (result < 0) result = 0.0;
+    }
+    return results;
+}
+
+double SeriesSnapshot::interpolateAt(double unix_time) const {
+    NA_METRIC_COUNT(INTERPOLATION_QUERIES, 1);
+    if (!series.empty() && unix_time > series.lastTimestamp()) return forecaster.forecast(unix_time);
+    return evaluateSeries(unix_time);
+}
+
+double SeriesSnapshot::evaluateSeries(double unix_time) const {
+    size_t n = series.size();
+    if (n == 0) return 0.0;
+    const double* times = series.timestamps();
+    const double* values = series.bandwidth();
+    if (n == 1) return values[0];
+    
+    // Batasi ke rentang deret
+    if (unix_time <= times[0]) return values[0];
+    if (unix_time >= times[n - 1]) return values[n - 1];
+    
+    // Cari segmen [x_k, x_k+1] yang memuat unix_time dengan pencarian biner
+    size_t k = series.upperBound(unix_time) - 1;
+    
+    // Jendela degree+1 titik di sekitar segmen, digeser jika menyentuh tepi deret
+    size_t points = std::min(static_cast<size_t>(series_degree) + 1, n);
+    size_t half = static_cast<size_t>(series_degree - 1) / 2;
+    size_t first = k > half ? k - half : 0;
+    if (first + points > n) first = n - points;
+    
+    // Polinom Lagrange lokal
+    double result = 0.0;
+    for (size_t j = first; j < first + points; j++) {
+        double basis = 1.0;
+        for (size_t m = first; m < first + points; m++) {
+            if (m == j) continue;
+            basis *= (unix_time - times[m]) / (times[j] - times[m]);
+        }
+        result += basis * values[j];
+    }
+    
+    // Bandwidth tidak mungkin negatif
+    return std::max(0.0, result);
+}
+
+std::vector<double> SeriesSnapshot::interpolateAt(const std::vector<double>& unix_times) const {
+    NA_METRIC_QUERY(STAGE_INTERPOLATION);
+    NA_METRIC_COUNT(INTERPOLATION_QUERIES, unix_times.size());
+    std::vector<double> results(unix_times.size());
+    double last = series.empty() ? 0.0 : series.lastTimestamp();
+    for (size_t i = 0; i < unix_times.size(); i++) {
+        results[i] = !series.empty() && unix_times[i] > last ? forecaster.forecast(unix_times[i])
+                                                          : evaluateSeries(unix_times[i]);
+    }
+    return results;
+}
+
+double SeriesSnapshot::simpsonIntegration(double start_time, double end_time) const {
+    NA_METRIC_COUNT(INTEGRATION_QUERIES, 1);
+    if (hourly.empty()) {
+        std::cerr << "Error: Tidak ada data tersedia untuk integrasi." << std::endl;
+        return 0.0;
+    }
+    
+    // Gunakan titik data yang ada dalam rentang
+    size_t first, last;
+    if (!findSampleRange(start_time, end_time, first, last) || last - first + 1 < 3) {
+        std::cerr << "Error: Titik data tidak cukup untuk aturan Simpson." << std::endl;
+        return 0.0;
+    }
+    
+    return simpsonFromIndex(first, last);
+}
+
+std::vector<double> SeriesSnapshot::simpsonIntegrationBatch(
+        const std::vector<std::pair<double, double>>& ranges) const {
+    NA_METRIC_QUERY(STAGE_INTEGRATION);
+    NA_METRIC_COUNT(INTEGRATION_QUERIES, ranges.size());
+    // Rentang dengan kurang dari 3 titik menghasilkan 0, tanpa pesan per kueri
+    std::vector<double> results(ranges.size(), 0.0);
+    for (size_t q = 0; q < ranges.size(); q++) {
+        size_t first, last;
+        if (findSampleRange(ranges[q].first, ranges[q].second, first, last) && last - first + 1 >= 3) {
+            results[q] = simpsonFromIndex(first, last);
+        }
+    }
+    return results;
+}
+
+void SeriesSnapshot::rebuildNumericIndex() {
+    size_t n = hourly.size();
+    const double* time_hours = hourly.timestamps();
+    const double* bandwidth = hourly.bandwidth();
+    {
+        NA_METRIC_STAGE(STAGE_STATISTICS);
+        hourly_statistics = computeTrafficStatistics(bandwidth, n);
+    }
+    
+    // Bobot barisentrik dihitung sekali per pemuatan data
+    interpolator.build(time_hours, bandwidth, n, lagrange_degree);
+    
+    // Jumlah prefix terpisah untuk indeks genap dan ganjil:
+    // parity_prefix[p][k] = jumlah bandwidth[j] untuk j < k dengan j % 2 == p
+    for (int p = 0; p < 2; p++) {
+        std::vector<double>& prefix = integration_index.parity_prefix[p];
+        prefix.assign(n + 1, 0.0);
+        for (size_t j = 0; j < n; j++) {
+            prefix[j + 1] = prefix[j] + (static_cast<int>(j % 2) == p ? bandwidth[j] : 0.0);
+        }
+    }
+    
+    // Grid seragam (misalnya jam 0..23) memungkinkan pencarian indeks tanpa biner
+    integration_index.uniform_grid = false;
+    if (n >= 2) {
+        double step = (time_hours[n - 1] - time_hours[0]) / (n - 1);
+        bool uniform = step > 0;
+        for (size_t i = 0; uniform && i < n; i++) {
+            uniform = std::abs(time_hours[i] - (time_hours[0] + i * step)) <= 1e-9 * step;
+        }
+        integration_index.uniform_grid = uniform;
+        integration_index.grid_start = time_hours[0];
+        integration_index.grid_step = step;
+    }
+}
+
+bool SeriesSnapshot::findSampleRange(double start_time, double end_time,
+                                      size_t& first, size_t& last) const {
+    size_t n = hourly.size();
+    const double* time_hours = hourly.timestamps();
+    if (n == 0 || !(start_time <= end_time)) return false;
+    
+    if (integration_index.uniform_grid) {
+        // Tebakan langsung dari grid, lalu koreksi satu langkah untuk galat pembulatan
+        const IntegrationIndex& index = integration_index;
+        double lo = std::ceil((start_time - index.grid_start) / index.grid_step);
+        double hi = std::floor((end_time - index.grid_start) / index.grid_step);
+        lo = std::min(std::max(lo, 0.0), static_cast<double>(n));
+        hi = std::min(std::max(hi, -1.0), static_cast<double>(n - 1));
+        long long f = static_cast<long long>(lo);
+        long long l = static_cast<long long>(hi);
+        while (f > 0 && time_hours[f - 1] >= start_time) f--;
+        while (f < static_cast<long long>(n) && time_hours[f] < start_time) f++;
+        while (l + 1 < static_cast<long long>(n) && time_hours[l + 1] <= end_time) l++;
+        while (l >= 0 && time_hours[l] > end_time) l--;
+        if (l < f) return false;
+        first = static_cast<size_t>(f);
+        last = static_cast<size_t>(l);
+        return true;
+    }
+    
+    size_t lower = hourly.lowerBound(start_time);
+    size_t upper = hourly.upperBound(end_time);
+    if (lower >= upper) return false;
+    first = lower;
+    last = upper - 1;
+    return true;
+}
+
+double SeriesSnapshot::simpsonFromIndex(size_t first, size_t last) const {
+    const double* time_hours = hourly.timestamps();
+    const double* bandwidth = hourly.bandwidth();
+    size_t n = last - first;
+    if (n == 0) return 0.0;
+    if (n == 1) {
+        // Dua titik: aturan trapesium
+        return 0.5 * (time_hours[last] - time_hours[first]) * (bandwidth[first] + bandwidth[last]);
+    }
+    
+    // Jumlah interval ganjil: tiga interval terakhir memakai aturan 3/8 Simpson
+    // sehingga sampel terakhir tidak dibuang
+    double tail = 0.0;
+    if (n % 2 != 0) {
+        size_t k = last - 3;
+        double h3 = (time_hours[last] - time_hours[k]) / 3.0;
+        tail = 3.0 * h3 / 8.0 * (bandwidth[k] + 3.0 * bandwidth[k + 1] +
+                                 3.0 * bandwidth[k + 2] + bandwidth[last]);
+        n -= 3;
+        if (n == 0) return tail;
+    }
+    
+    const std::vector<double>* prefix = integration_index.parity_prefix;
+    size_t even_parity = first % 2;
+    size_t odd_parity = 1 - even_parity;
+    
+    double h = (time_hours[first + n] - time_hours[first]) / n;
+    double integral = bandwidth[first] + bandwidth[first + n];
+    
+    // Tambahkan 4 * (suku berindeks ganjil): indeks first+1, first+3, ..., first+n-1
+    integral += 4 * (prefix[odd_parity][first + n] - prefix[odd_parity][first + 1]);
+    
+    // Tambahkan 2 * (suku berindeks genap): indeks first+2, ..., first+n-2
+    if (n >= 4) {
+        integral += 2 * (prefix[even_parity][first + n - 1] - prefix[even_parity][first + 2]);
+    }
+    
+    integral *= h / 3.0;
+    return integral + tail;
+}
+
+IntegrationResult SeriesSnapshot::integrateAdaptive(double start_hour, double end_hour,
+                                                     double tolerance) const {
+    NA_METRIC_QUERY(STAGE_INTEGRATION);
+    NA_METRIC_COUNT(INTEGRATION_QUERIES, 1);
+    if (interpolator.empty()) return IntegrationResult();
+    
+    // Integran sama dengan lagrangeInterpolation: dibatasi ke rentang data dan tidak negatif
+    double lo = hourly.firstTimestamp();
+    double hi = hourly.lastTimestamp();
+    return adaptiveSimpson([this, lo, hi](double t) {
+        return std::max(0.0, interpolator.evaluate(std::min(std::max(t, lo), hi)));
+    }, start_hour, end_hour, tolerance);
+}
+
+IntegrationResult SeriesSnapshot::integrateSeriesAdaptive(double start_unix, double end_unix,
+                                                           double tolerance, unsigned num_threads) const {
+    NA_METRIC_QUERY(STAGE_INTEGRATION);
+    NA_METRIC_COUNT(INTEGRATION_QUERIES, 1);
+    IntegrationResult total;
+    if (series.empty() || start_unix == end_unix) return total;
+    
+    double sign = 1.0;
+    if (end_unix < start_unix) {
+        std::swap(start_unix, end_unix);
+        sign = -1.0;
+    }
+    double span = end_unix - start_unix;
+    
+    // Potongan awal mengikuti kerapatan sampel agar lonjakan pendek tidak terlewat
+    double step = series.size() > 1
+        ? (series.lastTimestamp() - series.firstTimestamp()) / (series.size() - 1)
+        : interval_duration;
+    double wanted = std::ceil(span / (std::max(step, 1e-9) * SERIES_SAMPLES_PER_PIECE));
+    size_t pieces = static_cast<size_t>(std::min(std::max(wanted, 1.0),
+                                                 static_cast<double>(MAX_SERIES_PIECES)));
+    
+    // Integrasi dalam detik; toleransi dibagi proporsional dengan panjang potongan
+    double tolerance_seconds = tolerance * 3600.0;
+    std::vector<IntegrationResult> partial(pieces);
+    auto integrate_piece = [&](size_t p) {
+        double a = start_unix + span * p / pieces;
+        double b = p + 1 == pieces ? end_unix : start_unix + span * (p + 1) / pieces;
+        partial[p] = adaptiveSimpson([this](double t) { return evaluateSeries(t); },
+                                     a, b, tolerance_seconds * (b - a) / span);
+    };
+    
+    unsigned threads = 1;
+    if (span > PARALLEL_INTEGRATION_SECONDS) {
+        threads = num_threads ? num_threads : std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<size_t>(threads, pieces));
+    }
+    if (threads <= 1) {
+        for (size_t p = 0; p < pieces; p++) integrate_piece(p);
+    } else {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&, t]() {
+                for (size_t p = t; p < pieces; p += threads) integrate_piece(p);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    
+    // Dijumlahkan berurutan agar hasil tidak bergantung pada jumlah thread
+    for (const IntegrationResult& piece : partial) {
+        total.value += piece.value;
+        total.error_estimate += piece.error_estimate;
+        total.evaluations += piece.evaluations;
+        total.converged = total.converged && piece.converged;
+    }
+    total.value = sign * total.value / 3600.0;
+    total.error_estimate /= 3600.0;
+    return total;
+}
+
+RangeAggregate SeriesSnapshot::aggregateRange(double start_unix, double end_unix) const {
+    NA_METRIC_COUNT(RANGE_QUERIES, 1);
+    size_t first = series.lowerBound(start_unix);
+    size_t end = series.lowerBound(end_unix);
+    if (first >= end) return RangeAggregate();
+    return range_index.aggregate(series, first, end - 1);
+}
+
+double SeriesSnapshot::getPercentile(double percentile) const {
+    NA_METRIC_COUNT(PERCENTILE_QUERIES, 1);
+    return series_sketch.quantile(percentile / 100.0);
+}
+
+double SeriesSnapshot::getPercentile(double percentile, double start_hour, double end_hour) const {
+    NA_METRIC_COUNT(PERCENTILE_QUERIES, 1);
+    // Gabungkan sketsa jam yang beririsan dengan [start_hour, end_hour);
+    // rentang seperti 22-6 dianggap melewati tengah malam
+    QuantileSketch window(series_sketch.getRelativeAccuracy());
+    for (int hour = 0; hour < 24; hour++) {
+        bool inside = start_hour <= end_hour
+            ? (hour + 1 > start_hour && hour < end_hour)
+            : (hour + 1 > start_hour || hour < end_hour);
+        if (inside) window.merge(hour_of_day_sketches[hour]);
+    }
+    return window.quantile(percentile / 100.0);
+}
@@ -0,0 +1,122 @@
+#ifndef SERIES_SNAPSHOT_H
+#define SERIES_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "adaptive_simpson.h"
+#include "anomaly_detector.h"
+#include "barycentric.h"
+#include "flow_tracker.h"
+#include "quantile_sketch.h"
+#include "range_index.h"
+#include "seasonal_forecaster.h"
+#include "time_series_store.h"
+#include "traffic_statistics.h"
+
+// Satu versi data analisis yang tidak berubah setelah diterbitkan.
+//
+// NetworkAnalyzer membangun versi berikutnya secara terpisah lalu
+// menukarnya secara atomik; pembaca memegang shared_ptr ke versi yang
+// sedang dipakai sehingga kueri berjalan tanpa kunci atas data yang
+// konsisten, dan versi lama dibebaskan setelah pembaca terakhir selesai.
+// Semua metode publik const dan aman dipanggil dari banyak thread.
+class SeriesSnapshot {
+private:
+    friend class NetworkAnalyzer;
+
+    TimeSeriesStore series;            // Deret interval (timestamp Unix)
+    TimeSeriesStore hourly;            // Tabel per jam: timestamp = jam (0-24), tanpa paket
+    double interval_duration;
+    int lagrange_degree;               // Derajat polinom lokal; -1 = Lagrange global
+    int series_degree;                 // Derajat Lagrange sepotong-sepotong untuk deret penuh
+    uint64_t version;
+
+    // Indeks integral kumulatif: jumlah prefix bandwidth per paritas indeks,
+    // sehingga aturan Simpson pada rentang mana pun dihitung dalam O(1)
+    struct IntegrationIndex {
+        std::vector<double> parity_prefix[2];
+        bool uniform_grid = false;
+        double grid_start = 0.0;
+        double grid_step = 0.0;
+    } integration_index;
+
+    // Mesin interpolasi barisentrik atas tabel per jam
+    BarycentricInterpolator interpolator;
+
+    // Statistik dihitung sekali sebelum diterbitkan, bukan saat kueri,
+    // sehingga pembaca tidak pernah menulis ke snapshot
+    TrafficStatistics hourly_statistics;
+    TrafficStatistics series_statistics;
+
+    // Sketsa kuantil: satu untuk seluruh deret dan satu per jam dalam sehari (UTC)
+    QuantileSketch series_sketch;
+    QuantileSketch hour_of_day_sketches[24];
+
+    // Agregat rentang O(log n) dan rollup 5m/1h/1d, diperbarui setiap interval
+    RangeIndex range_index;
+
+    // Model musiman yang diperbarui setiap interval; sumber tabel per jam
+    SeasonalForecaster forecaster;
+
+    // Detektor lonjakan/penurunan/pergeseran level atas residual ramalan,
+    // dinilai per interval mulai hari kedua
+    AnomalyDetector anomaly_detector;
+
+    // Rincian mode aliran; nullptr jika data dimuat tanpa mode aliran
+    std::shared_ptr<const FlowTracker> flow_tracker;
+
+    // Hanya dipanggil penulis sebelum snapshot diterbitkan
+    void recordInterval(const TrafficData& point);
+    void computeSeriesStatistics();
+    void rebuildNumericIndex();   // Panggil setiap kali tabel per jam berubah
+    void buildForecastTable();    // Tabel per jam dari ramalan 24 jam ke depan
+
+    bool findSampleRange(double start_time, double end_time, size_t& first, size_t& last) const;
+    double simpsonFromIndex(size_t first, size_t last) const;
+    double evaluateSeries(double unix_time) const;   // Interpolan deret penuh tanpa metrik
+
+public:
+    SeriesSnapshot(double interval_duration = 300.0, int lagrange_degree = 3, int series_degree = 3);
+
+    // Interpolasi Lagrange atas tabel per jam
+    double lagrangeInterpolation(double target_time) const;
+    std::vector<double> lagrangeInterpolation(const std::vector<double>& target_times) const;
+
+    // Interpolasi langsung pada timestamp Unix atas seluruh deret teragregasi;
+    // setelah interval terakhir nilainya berasal dari model musiman
+    double interpolateAt(double unix_time) const;
+    std::vector<double> interpolateAt(const std::vector<double>& unix_times) const;
+    double forecastAt(double unix_time) const { return forecaster.forecast(unix_time); }
+
+    double simpsonIntegration(double start_time, double end_time) const;
+    std::vector<double> simpsonIntegrationBatch(const std::vector<std::pair<double, double>>& ranges) const;
+    IntegrationResult integrateAdaptive(double start_hour, double end_hour,
+                                        double tolerance = 1e-6) const;
+    IntegrationResult integrateSeriesAdaptive(double start_unix, double end_unix,
+                                              double tolerance = 1e-6,
+                                              unsigned num_threads = 0) const;  // 0 = semua core
+
+    const TrafficStatistics& getStatistics() const { return hourly_statistics; }
+    const TrafficStatistics& getSeriesStatistics() const { return series_statistics; }
+    double getPercentile(double percentile) const;  // 0-100, atas seluruh deret interval
+    double getPercentile(double percentile, double start_hour, double end_hour) const;
+    double getPercentileErrorBound() const { return series_sketch.getRelativeAccuracy(); }
+
+    // Min, maks, jumlah, dan paket atas interval yang dimulai dalam [start, end)
+    RangeAggregate aggregateRange(double start_unix, double end_unix) const;
+    const RollupSeries& getRollup(RollupLevel level) const { return range_index.getRollup(level); }
+    const QuantileSketch& getSeriesSketch() const { return series_sketch; }
+
+    const TimeSeriesStore& getSeries() const { return series; }
+    const TimeSeriesStore& getHourly() const { return hourly; }
+    const FlowTracker* getFlowTracker() const { return flow_tracker.get(); }
+    const SeasonalForecaster& getForecaster() const { return forecaster; }
+    const AnomalyDetector& getAnomalyDetector() const { return anomaly_detector; }
+    double getIntervalDuration() const { return interval_duration; }
+    int getLagrangeDegree() const { return lagrange_degree; }
+    int getSeriesInterpolationDegree() const { return series_degree; }
+    uint64_t getVersion() const { return version; }   // Naik setiap kali snapshot baru diterbitkan
+};
+
+#endif // SERIES_SNAPSHOT_H
@@ -0,0 +1,331 @@
+// Kesetaraan CSV/pcap/pcapng dan ketahanan pembaca pcap terhadap file terpotong.
+//
+// Satu seed capture sintetis ditulis sebagai CSV, pcap, dan pcapng; varian
+// pcap nanodetik, big-endian, dan pcapng big-endian diturunkan dari byte
+// yang sama. Semua varian harus menghasilkan deret interval yang identik.
+// Setiap potongan file pcap/pcapng yang tidak jatuh di batas record harus
+// dilaporkan lewat ScanResult::error tanpa membaca melewati end; buffer
+// diletakkan tepat sebelum halaman PROT_NONE sehingga bacaan berlebih
+// langsung gagal.
+#include "capture_generator.h"
+#include "network_analyzer.h"
+#include "pcap_file.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "GAGAL: " << message << std::endl;
+        failures++;
+    }
+}
+
+std::vector<char> readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream file(path, std::ios::binary);
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+uint32_t get32(const std::vector<char>& bytes, size_t offset) {
+    return pcap_file::load32(bytes.data() + offset, false);
+}
+
+void put32(std::vector<char>& bytes, size_t offset, uint32_t value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+void swap16At(std::vector<char>& bytes, size_t offset) {
+    uint16_t value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    value = pcap_file::swap16(value);
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+void swap32At(std::vector<char>& bytes, size_t offset) {
+    put32(bytes, offset, pcap_file::swap32(get32(bytes, offset)));
+}
+
+void swap64At(std::vector<char>& bytes, size_t offset) {
+    uint64_t value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(value));
+    value = pcap_file::swap64(value);
+    std::memcpy(bytes.data() + offset, &value, sizeof(value));
+}
+
+// Awal setiap record pcap (setelah header 24 byte) dan akhir file
+std::vector<size_t> pcapRecordStarts(const std::vector<char>& pcap) {
+    std::vector<size_t> starts;
+    for (size_t p = 24; p + 16 <= pcap.size(); p += 16 + get32(pcap, p + 8)) starts.push_back(p);
+    return starts;
+}
+
+// Awal setiap blok pcapng little-endian
+std::vector<size_t> pcapngBlockStarts(const std::vector<char>& pcapng) {
+    std::vector<size_t> starts;
+    for (size_t p = 0; p + 12 <= pcapng.size(); p += get32(pcapng, p + 4)) starts.push_back(p);
+    return starts;
+}
+
+// Ubah pcap mikrodetik little-endian hasil generator menjadi nanodetik
+// dan/atau big-endian; isi frame tidak berubah
+std::vector<char> convertPcap(const std::vector<char>& pcap, bool nano, bool big_endian) {
+    std::vector<char> out = pcap;
+    std::vector<size_t> records = pcapRecordStarts(pcap);
+    if (nano) {
+        put32(out, 0, pcap_file::PCAP_MAGIC_NANO);
+        for (size_t p : records) put32(out, p + 4, get32(out, p + 4) * 1000);
+    }
+    if (big_endian) {
+        swap32At(out, 0);
+        swap16At(out, 4);
+        swap16At(out, 6);
+        for (size_t offset = 8; offset < 24; offset += 4) swap32At(out, offset);
+        for (size_t p : records) {
+            for (size_t offset = 0; offset < 16; offset += 4) swap32At(out, p + offset);
+        }
+    }
+    return out;
+}
+
+// Tukar urutan byte semua field pcapng yang dihasilkan generator (SHB, IDB dengan
+// opsi, EPB)
+std::vector<char> swapPcapng(const std::vector<char>& pcapng) {
+    std::vector<char> out = pcapng;
+    for (size_t p : pcapngBlockStarts(pcapng)) {
+        uint32_t type = get32(pcapng, p);
+        uint32_t length = get32(pcapng, p + 4);
+        if (type == pcap_file::PCAPNG_SECTION_HEADER) {
+            swap32At(out, p + 8);
+            swap16At(out, p + 12);
+            swap16At(out, p + 14);
+            swap64At(out, p + 16);
+        } else if (type == pcap_file::PCAPNG_INTERFACE_DESCRIPTION) {
+            swap16At(out, p + 8);
+            swap16At(out, p + 10);
+            swap32At(out, p + 12);
+            // Opsi: kode dan panjang ditukar; nilai if_tsresol satu byte
+            for (size_t option = p + 16; option + 4 <= p + length - 4;) {
+                uint16_t option_length = pcap_file::load16(pcapng.data() + option + 2, false);
+                swap16At(out, option);
+                swap16At(out, option + 2);
+                option += 4 + ((option_length + 3u) & ~3u);
+            }
+        } else if (type == pcap_file::PCAPNG_ENHANCED_PACKET) {
+            for (size_t offset = 8; offset < 28; offset += 4) swap32At(out, p + offset);
+        }
+        swap32At(out, p);
+        swap32At(out, p + 4);
+        swap32At(out, p + length - 4);
+    }
+    return out;
+}
+
+// Salinan prefix yang berakhir tepat di batas halaman tak terbaca
+class GuardedBuffer {
+private:
+    char* mapping;
+    size_t mapping_size;
+    std::vector<char> fallback;
+    const char* data_begin;
+    size_t data_size;
+
+public:
+    GuardedBuffer(const char* source, size_t size) : mapping(nullptr), mapping_size(0), data_size(size) {
+#ifdef __linux__
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        size_t data_pages = (size + page - 1) / page;
+        mapping_size = (data_pages + 1) * page;
+        void* region = mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED) {
+            mapping = static_cast<char*>(region);
+            mprotect(mapping + data_pages * page, page, PROT_NONE);
+            char* begin = mapping + data_pages * page - size;
+            std::memcpy(begin, source, size);
+            data_begin = begin;
+            return;
+        }
+        mapping_size = 0;
+#endif
+        fallback.assign(source, source + size);
+        data_begin = fallback.data();
+    }
+    ~GuardedBuffer() {
+#ifdef __linux__
+        if (mapping) munmap(mapping, mapping_size);
+#endif
+    }
+    GuardedBuffer(const GuardedBuffer&) = delete;
+    GuardedBuffer& operator=(const GuardedBuffer&) = delete;
+
+    const char* begin() const { return data_begin; }
+    const char* end() const { return data_begin + data_size; }
+};
+
+pcap_file::ScanResult scanPrefix(const std::vector<char>& bytes, size_t size) {
+    GuardedBuffer buffer(bytes.data(), size);
+    return pcap_file::scanPackets(buffer.begin(), buffer.end(), true, [](const raw_csv::Row&) {});
+}
+
+// Setiap potongan di dalam record/blok dilaporkan sebagai galat dan hanya
+// record lengkap sebelumnya yang diteruskan
+void checkTruncation(const std::string& label, const std::vector<char>& bytes,
+                     const std::vector<size_t>& starts, size_t header_records) {
+    for (size_t cut = 1; cut < starts.front(); cut++) {
+        pcap_file::ScanResult result = scanPrefix(bytes, cut);
+        check(result.error != nullptr && result.packets == 0,
+              label + ": header terpotong pada byte " + std::to_string(cut) + " tidak dilaporkan");
+    }
+    // Blok header, record pertama, dan tiga record terakhir cukup untuk
+    // mencakup setiap posisi potong di header record, frame, dan padding
+    std::vector<size_t> indices;
+    for (size_t r = 0; r <= header_records && r < starts.size(); r++) indices.push_back(r);
+    for (size_t r = starts.size() > 3 ? starts.size() - 3 : 0; r < starts.size(); r++) {
+        if (r > header_records) indices.push_back(r);
+    }
+    for (size_t r : indices) {
+        size_t record_end = r + 1 < starts.size() ? starts[r + 1] : bytes.size();
+        size_t complete = r >= header_records ? r - header_records : 0;
+        for (size_t cut = starts[r] + 1; cut < record_end; cut++) {
+            pcap_file::ScanResult result = scanPrefix(bytes, cut);
+            check(result.error != nullptr && result.packets == complete,
+                  label + ": potongan pada byte " + std::to_string(cut) + " tidak dilaporkan");
+        }
+        size_t expected = r >= header_records ? complete + 1 : 0;
+        pcap_file::ScanResult whole = scanPrefix(bytes, record_end);
+        check(whole.error == nullptr && whole.packets == expected,
+              label + ": potongan di batas record " + std::to_string(record_end) + " dianggap rusak");
+    }
+}
+
+bool loadSeries(const std::string& path, NetworkAnalyzer& analyzer) {
+    analyzer.setQuiet(true);
+    bool loaded = analyzer.loadCapture(path);
+    check(loaded, "gagal memuat " + path);
+    return loaded;
+}
+
+void checkSameSeries(const std::string& label, const NetworkAnalyzer& expected, const NetworkAnalyzer& actual) {
+    std::shared_ptr<const SeriesSnapshot> expected_snapshot = expected.getSnapshot();
+    std::shared_ptr<const SeriesSnapshot> actual_snapshot = actual.getSnapshot();
+    const TimeSeriesStore& a = expected_snapshot->getSeries();
+    const TimeSeriesStore& b = actual_snapshot->getSeries();
+    check(a.size() == b.size(), label + ": jumlah interval berbeda (" + std::to_string(a.size()) +
+                                " vs " + std::to_string(b.size()) + ")");
+    if (a.size() != b.size()) return;
+    size_t mismatched = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.timestampAt(i) != b.timestampAt(i) || a.bandwidthAt(i) != b.bandwidthAt(i) ||
+            a.packetsAt(i) != b.packetsAt(i)) {
+            mismatched++;
+        }
+    }
+    check(mismatched == 0, label + ": " + std::to_string(mismatched) + " interval berbeda dari CSV");
+
+    TrafficStatistics x = expected.getSeriesStatistics();
+    TrafficStatistics y = actual.getSeriesStatistics();
+    check(x.count == y.count && x.min == y.min && x.max == y.max && x.mean == y.mean && x.stddev == y.stddev,
+          label + ": statistik deret berbeda dari CSV");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : ".";
+    std::string base = directory + "/capture_parity";
+
+    CaptureSpec spec;
+    spec.rows = 20000;
+    spec.seed = 7;
+    spec.duration_seconds = 2 * 86400.0;
+
+    spec.format = CAPTURE_CSV;
+    bool written = writeSyntheticCapture(base + ".csv", spec) > 0;
+    spec.format = CAPTURE_PCAP;
+    written = written && writeSyntheticCapture(base + ".pcap", spec) > 0;
+    spec.format = CAPTURE_PCAPNG;
+    written = written && writeSyntheticCapture(base + ".pcapng", spec) > 0;
+    if (!written) {
+        std::cerr << "Error: Tidak dapat menulis fixture ke " << directory << std::endl;
+        return 1;
+    }
+
+    std::vector<char> pcap = readFile(base + ".pcap");
+    std::vector<char> pcapng = readFile(base + ".pcapng");
+    struct Variant {
+        const char* suffix;
+        std::vector<char> bytes;
+    };
+    std::vector<Variant> variants = {
+        {"_micro_le.pcap", pcap},
+        {"_nano_le.pcap", convertPcap(pcap, true, false)},
+        {"_micro_be.pcap", convertPcap(pcap, false, true)},
+        {"_nano_be.pcap", convertPcap(pcap, true, true)},
+        {"_le.pcapng", pcapng},
+        {"_be.pcapng", swapPcapng(pcapng)},
+    };
+
+    NetworkAnalyzer reference;
+    if (!loadSeries(base + ".csv", reference)) return 1;
+    check(reference.getDataSize() > 100, "CSV acuan menghasilkan terlalu sedikit interval");
+
+    for (const Variant& variant : variants) {
+        std::string path = base + variant.suffix;
+        if (!writeFile(path, variant.bytes)) {
+            std::cerr << "Error: Tidak dapat menulis " << path << std::endl;
+            return 1;
+        }
+        NetworkAnalyzer analyzer;
+        if (loadSeries(path, analyzer)) checkSameSeries(variant.suffix, reference, analyzer);
+        std::remove(path.c_str());
+    }
+
+    // Potongan diuji pada capture kecil karena setiap posisi memindai ulang file
+    spec.rows = 200;
+    spec.format = CAPTURE_PCAP;
+    written = writeSyntheticCapture(base + ".pcap", spec) > 0;
+    spec.format = CAPTURE_PCAPNG;
+    written = written && writeSyntheticCapture(base + ".pcapng", spec) > 0;
+    if (written) {
+        std::vector<char> small_pcap = readFile(base + ".pcap");
+        std::vector<char> small_pcapng = readFile(base + ".pcapng");
+        std::vector<size_t> records = pcapRecordStarts(small_pcap);
+        std::vector<size_t> blocks = pcapngBlockStarts(small_pcapng);
+        checkTruncation("pcap", small_pcap, records, 0);
+        checkTruncation("pcap big-endian nano", convertPcap(small_pcap, true, true), records, 0);
+        // Dua blok pertama pcapng (SHB, IDB) bukan paket
+        checkTruncation("pcapng", small_pcapng, blocks, 2);
+        checkTruncation("pcapng big-endian", swapPcapng(small_pcapng), blocks, 2);
+    } else {
+        check(false, "tidak dapat menulis fixture kecil");
+    }
+
+    std::remove((base + ".csv").c_str());
+    std::remove((base + ".pcap").c_str());
+    std::remove((base + ".pcapng").c_str());
+
+    if (failures > 0) {
+        std::cerr << failures << " pemeriksaan gagal." << std::endl;
+        return 1;
+    }
+    std::cout << "Semua varian capture setara dan potongan file terdeteksi." << std::endl;
+    return 0;
+}
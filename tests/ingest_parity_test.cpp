@@ -0,0 +1,166 @@
+// Kesetaraan pemuat CSV mentah: getline, mmap, dan paralel.
+//
+// CSV yang sama, termasuk baris rusak, dimuat lewat ketiga jalur; mode
+// paralel dicoba dengan beberapa jumlah thread dan ukuran potongan minimum
+// sehingga batas potongan jatuh di tengah baris, tepat di awal baris, dan
+// menghasilkan potongan kosong. Semua harus menghasilkan deret interval yang identik.
+// File tanpa baris valid harus menerbitkan deret kosong di setiap mode,
+// menggantikan data yang dimuat sebelumnya.
+#include "capture_generator.h"
+#include "network_analyzer.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "GAGAL: " << message << std::endl;
+        failures++;
+    }
+}
+
+bool appendText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file << text;
+    return static_cast<bool>(file);
+}
+
+bool writeText(const std::string& path, const std::string& text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+    return static_cast<bool>(file);
+}
+
+void checkSameSeries(const std::string& label, const NetworkAnalyzer& expected, const NetworkAnalyzer& actual) {
+    std::shared_ptr<const SeriesSnapshot> expected_snapshot = expected.getSnapshot();
+    std::shared_ptr<const SeriesSnapshot> actual_snapshot = actual.getSnapshot();
+    const TimeSeriesStore& a = expected_snapshot->getSeries();
+    const TimeSeriesStore& b = actual_snapshot->getSeries();
+    check(a.size() == b.size(), label + ": jumlah interval berbeda (" + std::to_string(a.size()) +
+                                " vs " + std::to_string(b.size()) + ")");
+    if (a.size() != b.size()) return;
+    size_t mismatched = 0;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a.timestampAt(i) != b.timestampAt(i) || a.bandwidthAt(i) != b.bandwidthAt(i) ||
+            a.packetsAt(i) != b.packetsAt(i)) {
+            mismatched++;
+        }
+    }
+    check(mismatched == 0, label + ": " + std::to_string(mismatched) + " interval berbeda dari getline");
+
+    TrafficStatistics x = expected.getSeriesStatistics();
+    TrafficStatistics y = actual.getSeriesStatistics();
+    check(x.count == y.count && x.min == y.min && x.max == y.max && x.mean == y.mean && x.stddev == y.stddev,
+          label + ": statistik deret berbeda dari getline");
+}
+
+// Muat file lewat mode paralel dengan konfigurasi tertentu
+bool loadParallel(NetworkAnalyzer& analyzer, const std::string& path, unsigned threads, size_t chunk_bytes) {
+    analyzer.setQuiet(true);
+    analyzer.setParallelChunkBytes(chunk_bytes);
+    return analyzer.loadRawDataParallel(path, threads);
+}
+
+void checkParity(const std::string& path, const std::string& name) {
+    NetworkAnalyzer reference;
+    reference.setQuiet(true);
+    if (!reference.loadRawData(path)) {
+        check(false, name + ": gagal memuat lewat getline");
+        return;
+    }
+    check(reference.getDataSize() > 10, name + ": CSV acuan menghasilkan terlalu sedikit interval");
+
+    NetworkAnalyzer mapped;
+    mapped.setQuiet(true);
+    check(mapped.loadRawDataMapped(path), name + ": gagal memuat lewat mmap");
+    checkSameSeries(name + " mmap", reference, mapped);
+
+    const unsigned thread_counts[] = {1, 2, 3, 4, 7, 16};
+    // 1 byte: setiap thread mendapat potongan; 1 MB: file kecil tetap satu potongan
+    const size_t chunk_sizes[] = {1, 37, 4096, 1 << 20};
+    for (unsigned threads : thread_counts) {
+        for (size_t chunk_bytes : chunk_sizes) {
+            std::string label = name + " paralel " + std::to_string(threads) + " thread, potongan " +
+                                std::to_string(chunk_bytes);
+            NetworkAnalyzer parallel;
+            if (!loadParallel(parallel, path, threads, chunk_bytes)) {
+                check(false, label + ": gagal memuat");
+                continue;
+            }
+            checkSameSeries(label, reference, parallel);
+        }
+    }
+}
+
+void checkEmptyReplacesPrevious(const std::string& data_path, const std::string& empty_path) {
+    NetworkAnalyzer getline_mode, mapped, parallel;
+    getline_mode.setQuiet(true);
+    mapped.setQuiet(true);
+    bool loaded = getline_mode.loadRawData(data_path) && mapped.loadRawDataMapped(data_path) &&
+                  loadParallel(parallel, data_path, 4, 1);
+    check(loaded, "gagal memuat data sebelum file kosong");
+
+    check(getline_mode.loadRawData(empty_path), "getline: file tanpa paket ditolak");
+    check(mapped.loadRawDataMapped(empty_path), "mmap: file tanpa paket ditolak");
+    check(loadParallel(parallel, empty_path, 4, 1), "paralel: file tanpa paket ditolak");
+    check(getline_mode.getDataSize() == 0, "getline: data lama tetap aktif setelah file tanpa paket");
+    check(mapped.getDataSize() == 0, "mmap: data lama tetap aktif setelah file tanpa paket");
+    check(parallel.getDataSize() == 0, "paralel: data lama tetap aktif setelah file tanpa paket");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string directory = argc > 1 ? argv[1] : ".";
+    std::string base = directory + "/ingest_parity";
+    std::string csv = base + ".csv";
+    std::string empty = base + "_kosong.csv";
+
+    CaptureSpec spec;
+    spec.rows = 5000;
+    spec.seed = 3;
+    spec.duration_seconds = 2 * 86400.0;
+    if (writeSyntheticCapture(csv, spec) == 0) {
+        std::cerr << "Error: Tidak dapat menulis " << csv << std::endl;
+        return 1;
+    }
+    // Paket terlambat (sebelum paket pertama dan di tengah deret), timestamp
+    // yang melompat empat tahun, baris rusak yang harus dilewati semua mode,
+    // field berkutip dan CRLF yang harus diterima, serta baris terakhir
+    // tanpa '\n'
+    bool written = appendText(csv, "1699999000.25,10.0.0.1,10.0.0.2,TCP,1500\n"
+                                   "1700050000.5,10.0.0.3,10.0.0.4,UDP,64\n"
+                                   "1826230400.0,10.0.0.9,10.0.0.2,TCP,40\n"
+                                   " bad,row\n"
+                                   "1700060000.0,10.0.0.1,10.0.0.2,TCP, 70\n"
+                                   "1700060001.0,10.0.0.1,10.0.0.2,TCP,\n"
+                                   "1700060002.0,10.0.0.1,10.0.0.2\n"
+                                   "\n"
+                                   "\"1700060003.5\",\"10.0.0.7\",\"10.0.0.8\",\"TCP\",\"512\"\r\n"
+                                   "1700060004.5,10.0.0.7,10.0.0.8,UDP,128 \r\n"
+                                   "1700172800.75,10.0.0.5,10.0.0.6,TCP,999") &&
+                   writeText(empty, "Timestamp,Source IP,Destination IP,Protocol,Length\n");
+    if (!written) {
+        std::cerr << "Error: Tidak dapat menulis fixture" << std::endl;
+        return 1;
+    }
+
+    checkParity(csv, "capture sintetis");
+    checkEmptyReplacesPrevious(csv, empty);
+
+    std::remove(csv.c_str());
+    std::remove(empty.c_str());
+
+    if (failures > 0) {
+        std::cerr << failures << " pemeriksaan gagal." << std::endl;
+        return 1;
+    }
+    std::cout << "Pemuat getline, mmap, dan paralel menghasilkan deret yang sama." << std::endl;
+    return 0;
+}
@@ -0,0 +1,241 @@
+// Indeks agregat rentang dibandingkan dengan pemindaian brute-force.
+//
+// SegmentTree diuji untuk setiap ukuran di sekitar batas penggandaan
+// kapasitas. RangeIndex diuji setelah setiap append, termasuk jendela
+// yang mencakup blok parsial dan blok terakhir yang belum penuh. Rollup
+// dibangun ulang dari nol dan dibandingkan per ember. Bandwidth dipilih
+// kelipatan 1/16 sehingga jumlah dalam urutan apa pun eksak dan semua
+// perbandingan dapat memakai kesamaan persis.
+#include "range_index.h"
+#include "time_series_store.h"
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        // Batasi keluaran bila satu kesalahan berulang di banyak jendela
+        if (failures < 20) std::cerr << "GAGAL: " << message << std::endl;
+        failures++;
+    }
+}
+
+bool sameAggregate(const RangeAggregate& a, const RangeAggregate& b) {
+    if (a.count != b.count || a.packets != b.packets || a.sum != b.sum) return false;
+    return a.count == 0 || (a.min == b.min && a.max == b.max);
+}
+
+std::string describe(const RangeAggregate& a) {
+    return "count=" + std::to_string(a.count) + " min=" + std::to_string(a.min) +
+           " max=" + std::to_string(a.max) + " sum=" + std::to_string(a.sum) +
+           " packets=" + std::to_string(a.packets);
+}
+
+void checkAggregate(const RangeAggregate& actual, const RangeAggregate& expected, const std::string& label) {
+    check(sameAggregate(actual, expected), label + ": " + describe(actual) + ", seharusnya " + describe(expected));
+}
+
+// Generator kongruensial linear agar urutan data sama di setiap platform
+struct Lcg {
+    uint64_t state;
+    explicit Lcg(uint64_t seed) : state(seed) {}
+    uint32_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(state >> 33);
+    }
+};
+
+RangeAggregate leafFor(Lcg& random) {
+    RangeAggregate leaf;
+    size_t values = random.next() % 3;   // Daun kosong juga harus ditangani
+    for (size_t v = 0; v < values; v++) {
+        leaf.add((random.next() % 16000) / 16.0, random.next() % 500);
+    }
+    return leaf;
+}
+
+void testSegmentTree() {
+    Lcg random(11);
+    SegmentTree tree;
+    std::vector<RangeAggregate> leaves;
+    // 1..130 daun melewati setiap penggandaan sampai kapasitas 256
+    for (size_t n = 1; n <= 130; n++) {
+        leaves.push_back(leafFor(random));
+        tree.append(leaves.back());
+        check(tree.size() == n, "SegmentTree::size setelah " + std::to_string(n) + " append");
+
+        // Ganti satu daun lama agar set() ikut teruji di setiap kapasitas
+        size_t replaced = random.next() % n;
+        leaves[replaced] = leafFor(random);
+        tree.set(replaced, leaves[replaced]);
+
+        for (size_t first = 0; first < n; first++) {
+            RangeAggregate expected;
+            for (size_t last = first; last < n; last++) {
+                expected.merge(leaves[last]);
+                RangeAggregate actual = tree.query(first, last);
+                if (sameAggregate(actual, expected)) continue;
+                checkAggregate(actual, expected,
+                               "SegmentTree n=" + std::to_string(n) + " [" + std::to_string(first) + ", " +
+                                   std::to_string(last) + "]");
+            }
+        }
+        check(tree.query(n - 1, n).count == 0, "SegmentTree menjawab rentang di luar ukuran");
+    }
+}
+
+// Jumlah blok melewati pangkat dua: batas penggandaan pohon blok
+bool nearCapacityBoundary(size_t n) {
+    for (size_t blocks = 1; blocks <= 64; blocks *= 2) {
+        size_t edge = blocks * RangeIndex::BLOCK_SIZE;
+        if (n + 1 >= edge && n <= edge + 1) return true;
+    }
+    return false;
+}
+
+void checkWindow(const RangeIndex& index, const TimeSeriesStore& series, size_t first, size_t last,
+                 const RangeAggregate& expected) {
+    // Label hanya dibangun saat gagal; jendela yang diperiksa mencapai jutaan
+    RangeAggregate actual = index.aggregate(series, first, last);
+    if (sameAggregate(actual, expected)) return;
+    checkAggregate(actual, expected,
+                   "RangeIndex n=" + std::to_string(series.size()) + " [" + std::to_string(first) + ", " +
+                       std::to_string(last) + "]");
+}
+
+void checkRangeIndexWindows(const RangeIndex& index, const TimeSeriesStore& series, Lcg& random) {
+    size_t n = series.size();
+    const double* bandwidth = series.bandwidth();
+    const int64_t* packets = series.packets();
+
+    if (n <= 4 * RangeIndex::BLOCK_SIZE || nearCapacityBoundary(n)) {
+        // Semua jendela; pembanding diperpanjang satu interval per langkah
+        for (size_t first = 0; first < n; first++) {
+            RangeAggregate expected;
+            for (size_t last = first; last < n; last++) {
+                expected.add(bandwidth[last], packets[last]);
+                checkWindow(index, series, first, last, expected);
+            }
+        }
+        return;
+    }
+
+    // Jendela yang berakhir di blok terakhir (mungkin belum penuh)
+    RangeAggregate suffix;
+    for (size_t first = n; first-- > 0;) {
+        suffix.add(bandwidth[first], packets[first]);
+        checkWindow(index, series, first, n - 1, suffix);
+    }
+    // Jendela dari awal deret, sehingga setiap batas blok menjadi ujung kanan
+    RangeAggregate prefix;
+    for (size_t last = 0; last < n; last++) {
+        prefix.add(bandwidth[last], packets[last]);
+        checkWindow(index, series, 0, last, prefix);
+    }
+    // Jendela acak dengan ujung di tengah blok
+    for (int w = 0; w < 32; w++) {
+        size_t first = random.next() % n;
+        size_t last = first + random.next() % (n - first);
+        RangeAggregate expected;
+        for (size_t i = first; i <= last; i++) expected.add(bandwidth[i], packets[i]);
+        checkWindow(index, series, first, last, expected);
+    }
+}
+
+void checkRollups(const RangeIndex& index, const TimeSeriesStore& series, Lcg& random) {
+    size_t n = series.size();
+    for (int l = 0; l < ROLLUP_LEVEL_COUNT; l++) {
+        RollupLevel level = static_cast<RollupLevel>(l);
+        const RollupSeries& rollup = index.getRollup(level);
+        double width = rollupWidth(level);
+        std::string label = std::string("rollup ") + rollupLevelName(level) + " n=" + std::to_string(n);
+
+        std::vector<double> starts;
+        std::vector<RangeAggregate> buckets;
+        for (size_t i = 0; i < n; i++) {
+            double start = std::floor(series.timestampAt(i) / width) * width;
+            if (starts.empty() || start != starts.back()) {
+                starts.push_back(start);
+                buckets.push_back(RangeAggregate());
+            }
+            buckets.back().add(series.bandwidthAt(i), series.packetsAt(i));
+        }
+
+        check(rollup.size() == starts.size(), label + ": jumlah ember " + std::to_string(rollup.size()) +
+                                                  ", seharusnya " + std::to_string(starts.size()));
+        if (rollup.size() != starts.size()) continue;
+        for (size_t b = 0; b < starts.size(); b++) {
+            check(rollup.bucketStart(b) == starts[b], label + ": awal ember " + std::to_string(b));
+            checkAggregate(rollup.bucket(b), buckets[b], label + " ember " + std::to_string(b));
+        }
+
+        // [start, end) mencakup ember yang dimulai di dalamnya; ujung acak
+        // boleh jatuh di antara awal ember maupun di luar deret
+        double low = starts.front() - width;
+        double span = starts.back() - starts.front() + 3 * width;
+        for (int w = 0; w < 8; w++) {
+            double start = low + span * (random.next() % 1024) / 1024.0;
+            double end = start + span * (random.next() % 1024) / 1024.0;
+            if (w == 0) {
+                start = starts.front();
+                end = starts.back() + width;
+            }
+            RangeAggregate expected;
+            for (size_t b = 0; b < starts.size(); b++) {
+                if (starts[b] >= start && starts[b] < end) expected.merge(buckets[b]);
+            }
+            checkAggregate(rollup.aggregate(start, end), expected,
+                           label + " [" + std::to_string(start) + ", " + std::to_string(end) + ")");
+        }
+    }
+}
+
+void testRangeIndex() {
+    Lcg random(24);
+    TimeSeriesStore series;
+    RangeIndex index;
+    double timestamp = 1700000000.0 + 37.0;   // Tidak selaras ke batas ember mana pun
+    // 1100 interval: pohon blok melewati kapasitas 1, 2, ..., 64
+    for (size_t n = 1; n <= 1100; n++) {
+        series.append(timestamp, (random.next() % 16000) / 16.0, random.next() % 1000);
+        index.add(series);
+        checkRangeIndexWindows(index, series, random);
+        checkRollups(index, series, random);
+
+        // Interval 45 detik dengan jeda sesekali agar ada ember kosong
+        timestamp += 45.0;
+        if (n % 97 == 0) timestamp += 5400.0;
+        if (n % 401 == 0) timestamp += 2 * 86400.0;
+    }
+
+    check(index.aggregate(series, 5, 4).count == 0, "RangeIndex menjawab rentang terbalik");
+    check(index.aggregate(series, 0, series.size()).count == 0, "RangeIndex menjawab rentang di luar deret");
+
+    index.clear();
+    check(index.getRollup(ROLLUP_DAY).size() == 0, "rollup tidak kosong setelah clear");
+    TimeSeriesStore fresh;
+    fresh.append(timestamp, 2.5, 3);
+    index.add(fresh);
+    checkAggregate(index.aggregate(fresh, 0, 0), index.getRollup(ROLLUP_5MIN).bucket(0),
+                   "RangeIndex setelah clear");
+}
+
+} // namespace
+
+int main() {
+    testSegmentTree();
+    testRangeIndex();
+
+    if (failures > 0) {
+        std::cerr << failures << " pemeriksaan gagal." << std::endl;
+        return 1;
+    }
+    std::cout << "Agregat rentang dan rollup sama dengan pemindaian brute-force." << std::endl;
+    return 0;
+}
@@ -0,0 +1,193 @@
+// TrafficAggregator dibandingkan dengan agregasi std::map sederhana.
+//
+// Paket datang dalam urutan acak (termasuk makin awal dari paket pertama
+// sehingga array tumbuh ke depan), dengan timestamp liar yang melompat
+// bertahun-tahun. Hasil emitAll, merge dari beberapa agregator parsial,
+// dan emitCompleted bertahap harus sama dengan acuan, sementara interval
+// liar tidak boleh memperluas array padat.
+#include "traffic_aggregator.h"
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& message) {
+    if (!condition) {
+        std::cerr << "GAGAL: " << message << std::endl;
+        failures++;
+    }
+}
+
+struct Lcg {
+    uint64_t state;
+    explicit Lcg(uint64_t seed) : state(seed) {}
+    uint32_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<uint32_t>(state >> 33);
+    }
+};
+
+struct Packet {
+    double timestamp;
+    long long length;
+};
+
+struct Interval {
+    double start;
+    long long bytes;
+    long long packets;
+    bool operator==(const Interval& other) const {
+        return start == other.start && bytes == other.bytes && packets == other.packets;
+    }
+};
+
+const double WIDTH = 60.0;
+const double ORIGIN = 1700000000.5;
+
+std::vector<Interval> reference(const std::vector<Packet>& packets) {
+    std::map<long long, Interval> buckets;
+    for (const Packet& packet : packets) {
+        long long id = static_cast<long long>(std::floor((packet.timestamp - ORIGIN) / WIDTH));
+        Interval& interval = buckets[id];
+        interval.start = ORIGIN + id * WIDTH;
+        interval.bytes += packet.length;
+        interval.packets++;
+    }
+    std::vector<Interval> result;
+    for (const auto& entry : buckets) result.push_back(entry.second);
+    return result;
+}
+
+std::vector<Interval> drain(TrafficAggregator& aggregator) {
+    std::vector<Interval> result;
+    aggregator.emitAll([&result](double start, long long bytes, long long packets) {
+        result.push_back({start, bytes, packets});
+    });
+    return result;
+}
+
+void checkSame(const std::string& label, const std::vector<Interval>& actual, const std::vector<Interval>& expected) {
+    check(actual.size() == expected.size(), label + ": jumlah interval " + std::to_string(actual.size()) +
+                                                ", seharusnya " + std::to_string(expected.size()));
+    if (actual.size() == expected.size()) check(actual == expected, label + ": isi interval berbeda");
+}
+
+// Paket pertama di ORIGIN, sisanya acak dalam dua hari di sekitarnya
+// (separuh sebelum paket pertama) ditambah beberapa timestamp liar
+std::vector<Packet> makePackets(size_t count, Lcg& random) {
+    std::vector<Packet> packets;
+    packets.push_back({ORIGIN, 100});
+    const double strays[] = {ORIGIN + 4 * 365 * 86400.0, ORIGIN - 3 * 365 * 86400.0, ORIGIN + 400 * 86400.0};
+    for (size_t i = 1; i < count; i++) {
+        double offset = (static_cast<double>(random.next() % 172800000) / 1000.0) - 86400.0;
+        packets.push_back({ORIGIN + offset, 40 + random.next() % 1460});
+        if (i % 997 == 0) packets.push_back({strays[(i / 997) % 3], 1});
+    }
+    return packets;
+}
+
+void testEmitAllAndMerge() {
+    Lcg random(4);
+    std::vector<Packet> packets = makePackets(20000, random);
+    std::vector<Interval> expected = reference(packets);
+
+    TrafficAggregator whole(WIDTH);
+    for (const Packet& packet : packets) whole.addPacket(packet.timestamp, packet.length);
+    check(whole.getOutOfRangePackets() == 0, "paket valid dianggap di luar jangkauan");
+    check(whole.getOutlierIntervals() == 3, "interval liar tidak disimpan terpisah: " +
+                                                 std::to_string(whole.getOutlierIntervals()));
+    // Dua hari pada 60 detik adalah 2880 interval; tanpa batas celah array
+    // akan mencakup tujuh tahun
+    check(whole.getOpenIntervals() < 4 * 2880, "array padat diperluas oleh timestamp liar: " +
+                                                   std::to_string(whole.getOpenIntervals()));
+    checkSame("emitAll", drain(whole), expected);
+
+    // Parsial seperti ingest paralel: titik awal sama, potongan berurutan
+    const size_t chunk_counts[] = {2, 3, 7};
+    for (size_t chunks : chunk_counts) {
+        std::vector<TrafficAggregator> partials(chunks, TrafficAggregator(WIDTH));
+        for (size_t c = 0; c < chunks; c++) {
+            partials[c].setOrigin(ORIGIN);
+            for (size_t i = packets.size() * c / chunks; i < packets.size() * (c + 1) / chunks; i++) {
+                partials[c].addPacket(packets[i].timestamp, packets[i].length);
+            }
+        }
+        TrafficAggregator merged(WIDTH);
+        merged.setOrigin(ORIGIN);
+        for (const TrafficAggregator& partial : partials) merged.merge(partial);
+        check(merged.getPacketCount() == packets.size(), "merge kehilangan paket");
+        checkSame("merge " + std::to_string(chunks) + " potongan", drain(merged), expected);
+    }
+}
+
+void testFollowEmission() {
+    // Paket hampir berurutan seperti mode follow; interval selesai dikeluarkan
+    // bertahap dan paket untuk interval yang sudah keluar dihitung terlambat
+    Lcg random(9);
+    std::vector<Packet> packets;
+    for (size_t i = 0; i < 30000; i++) {
+        // Paket pertama menjadi titik awal, sama dengan acuan
+        double jitter = i == 0 ? 0.0 : static_cast<double>(random.next() % 30000) / 1000.0;
+        packets.push_back({ORIGIN + i * 3.0 - jitter, 64 + random.next() % 1000});
+    }
+
+    TrafficAggregator aggregator(WIDTH);
+    std::vector<Interval> emitted;
+    auto collect = [&emitted](double start, long long bytes, long long count) {
+        emitted.push_back({start, bytes, count});
+    };
+    std::vector<Packet> accepted;
+    for (size_t i = 0; i < packets.size(); i++) {
+        size_t late = aggregator.getLatePackets();
+        aggregator.addPacket(packets[i].timestamp, packets[i].length);
+        if (aggregator.getLatePackets() == late) accepted.push_back(packets[i]);
+        if (i % 100 == 0) aggregator.emitCompleted(collect);
+    }
+    aggregator.emitAll(collect);
+    checkSame("emitCompleted bertahap", emitted, reference(accepted));
+    check(aggregator.getOpenIntervals() == 0, "interval tersisa setelah emitAll");
+}
+
+void testFrontGrowthIsAmortized() {
+    // Setiap paket satu interval lebih awal dari sebelumnya: dulu setiap paket
+    // menggeser seluruh array (kuadratik), kini ruang depan tumbuh geometris
+    const size_t count = 400000;
+    TrafficAggregator aggregator(1.0, 10 * 86400.0);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; i++) aggregator.addPacket(ORIGIN - static_cast<double>(i), 1);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    size_t emitted = 0;
+    double previous = -INFINITY;
+    bool ordered = true;
+    aggregator.emitAll([&](double interval_start, long long, long long) {
+        ordered = ordered && interval_start > previous;
+        previous = interval_start;
+        emitted++;
+    });
+    check(emitted == count && ordered, "pertumbuhan ke depan mengacak atau kehilangan interval");
+    // Versi kuadratik membutuhkan puluhan detik untuk jumlah ini
+    check(elapsed.count() < 5.0, "pertumbuhan ke depan terlalu lambat: " + std::to_string(elapsed.count()) + " s");
+}
+
+} // namespace
+
+int main() {
+    testEmitAllAndMerge();
+    testFollowEmission();
+    testFrontGrowthIsAmortized();
+
+    if (failures > 0) {
+        std::cerr << failures << " pemeriksaan gagal." << std::endl;
+        return 1;
+    }
+    std::cout << "Agregasi ember sama dengan acuan std::map." << std::endl;
+    return 0;
+}
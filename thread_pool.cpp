@@ -0,0 +1,111 @@
+#include "thread_pool.h"
+#include <exception>
+#include <iostream>
+
+namespace {
+
+// Worker yang sedang menjalankan thread ini, untuk mengarahkan submit bersarang
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local unsigned current_index = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned num_threads)
+    : queued(0), pending(0), next_queue(0), stopping(false) {
+    if (num_threads == 0) num_threads = std::thread::hardware_concurrency();
+    if (num_threads == 0) num_threads = 1;
+
+    for (unsigned i = 0; i < num_threads; i++) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (unsigned i = 0; i < num_threads; i++) {
+        workers.emplace_back(&ThreadPool::run, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex);
+        stopping = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    unsigned index = current_pool == this
+        ? current_index
+        : static_cast<unsigned>(next_queue.fetch_add(1) % queues.size());
+
+    pending.fetch_add(1);
+    {
+        // Dinaikkan sebelum tugas masuk antrean dan di bawah state_mutex agar
+        // penghitung tidak pernah turun di bawah nol dan worker yang sedang
+        // memeriksa predikat tidak melewatkan notifikasi
+        std::lock_guard<std::mutex> lock(state_mutex);
+        queued.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    work_available.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(state_mutex);
+    all_done.wait(lock, [this] { return pending.load() == 0; });
+}
+
+bool ThreadPool::tryTake(unsigned index, std::function<void()>& task) {
+    // Antrean sendiri: ambil dari belakang
+    {
+        WorkerQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // Curi dari depan antrean worker lain, mulai dari tetangga berikutnya
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue& victim = *queues[(index + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(unsigned index) {
+    current_pool = this;
+    current_index = index;
+
+    while (true) {
+        std::function<void()> task;
+        if (tryTake(index, task)) {
+            queued.fetch_sub(1);
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Error: Tugas thread pool gagal: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Error: Tugas thread pool gagal." << std::endl;
+            }
+            if (pending.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> lock(state_mutex);
+                all_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state_mutex);
+        work_available.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping && queued.load() == 0) return;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Kumpulan thread dengan pencurian kerja (work stealing).
+//
+// Setiap worker memiliki antrean dua ujung sendiri. Tugas dari luar pool
+// dibagikan bergiliran ke antrean worker; tugas yang dikirim dari dalam
+// tugas lain masuk ke antrean worker itu sendiri. Worker mengambil dari
+// ujung belakang antreannya (LIFO, data masih hangat di cache) dan, jika
+// kosong, mencuri dari ujung depan antrean worker lain, sehingga file besar
+// yang kebetulan menumpuk di satu worker tetap tersebar ke semua core.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex state_mutex;
+    std::condition_variable work_available;
+    std::condition_variable all_done;
+    std::atomic<size_t> queued;    // Tugas di antrean, belum diambil
+    std::atomic<size_t> pending;   // Tugas dikirim tetapi belum selesai
+    std::atomic<size_t> next_queue;
+    bool stopping;
+
+    void run(unsigned index);
+    bool tryTake(unsigned index, std::function<void()>& task);
+
+public:
+    explicit ThreadPool(unsigned num_threads = 0);  // 0 = semua core
+    ~ThreadPool();
+
+    void submit(std::function<void()> task);
+    void wait();   // Blok sampai semua tugas yang dikirim selesai
+
+    unsigned size() const { return static_cast<unsigned>(workers.size()); }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+};
+
+#endif // THREAD_POOL_H
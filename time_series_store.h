@@ -0,0 +1,112 @@
+#ifndef TIME_SERIES_STORE_H
+#define TIME_SERIES_STORE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Satu interval sebagai nilai; penyimpanan sebenarnya kolumnar (TimeSeriesStore)
+struct TrafficData {
+    double timestamp;      // Cap waktu Unix
+    double bandwidth_mbps; // Bandwidth dalam Mbps
+    long long packet_count; // Jumlah paket dalam interval ini
+};
+
+// Alokator dengan perataan baris cache agar setiap kolom dimulai pada batas
+// 64 byte dan loop SIMD tidak membutuhkan prolog untuk elemen yang tidak rata
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+    typedef T value_type;
+    template <typename U> struct rebind { typedef AlignedAllocator<U, Alignment> other; };
+
+    AlignedAllocator() noexcept {}
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* pointer, size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+// Deret waktu kolumnar: timestamp, bandwidth, dan jumlah paket disimpan
+// dalam tiga array rapat yang sejajar per indeks. Setiap lintasan numerik
+// hanya membaca kolom yang dibutuhkannya dengan langkah satu elemen, dan
+// kolom dapat ditulis/dimuat ke file biner tanpa konversi.
+//
+// Dipakai untuk deret interval (timestamp Unix) maupun tabel per jam
+// (timestamp berupa jam 0-24). Timestamp diharapkan naik.
+class TimeSeriesStore {
+public:
+    typedef std::vector<double, AlignedAllocator<double>> DoubleColumn;
+    typedef std::vector<int64_t, AlignedAllocator<int64_t>> CountColumn;
+
+private:
+    DoubleColumn timestamp_column;
+    DoubleColumn bandwidth_column;
+    CountColumn packet_column;
+
+public:
+    void reserve(size_t count) {
+        timestamp_column.reserve(count);
+        bandwidth_column.reserve(count);
+        packet_column.reserve(count);
+    }
+    void clear() {
+        timestamp_column.clear();
+        bandwidth_column.clear();
+        packet_column.clear();
+    }
+    void append(double timestamp, double bandwidth_mbps, int64_t packet_count = 0) {
+        timestamp_column.push_back(timestamp);
+        bandwidth_column.push_back(bandwidth_mbps);
+        packet_column.push_back(packet_count);
+    }
+    void append(const TrafficData& point) {
+        append(point.timestamp, point.bandwidth_mbps, point.packet_count);
+    }
+    // packets boleh nullptr (kolom diisi nol)
+    void assign(const double* timestamps, const double* bandwidths, const int64_t* packets, size_t count) {
+        timestamp_column.assign(timestamps, timestamps + count);
+        bandwidth_column.assign(bandwidths, bandwidths + count);
+        if (packets) packet_column.assign(packets, packets + count);
+        else packet_column.assign(count, 0);
+    }
+
+    size_t size() const { return timestamp_column.size(); }
+    bool empty() const { return timestamp_column.empty(); }
+
+    const double* timestamps() const { return timestamp_column.data(); }
+    const double* bandwidth() const { return bandwidth_column.data(); }
+    const int64_t* packets() const { return packet_column.data(); }
+
+    double timestampAt(size_t index) const { return timestamp_column[index]; }
+    double bandwidthAt(size_t index) const { return bandwidth_column[index]; }
+    int64_t packetsAt(size_t index) const { return packet_column[index]; }
+    TrafficData at(size_t index) const {
+        return {timestamp_column[index], bandwidth_column[index], packet_column[index]};
+    }
+    double firstTimestamp() const { return timestamp_column.front(); }
+    double lastTimestamp() const { return timestamp_column.back(); }
+
+    // Indeks pertama dengan timestamp >= t / > t (size() jika tidak ada)
+    size_t lowerBound(double t) const {
+        return static_cast<size_t>(std::lower_bound(timestamp_column.begin(), timestamp_column.end(), t) -
+                                   timestamp_column.begin());
+    }
+    size_t upperBound(double t) const {
+        return static_cast<size_t>(std::upper_bound(timestamp_column.begin(), timestamp_column.end(), t) -
+                                   timestamp_column.begin());
+    }
+};
+
+#endif // TIME_SERIES_STORE_H
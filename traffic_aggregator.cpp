@@ -0,0 +1,125 @@
+#include "traffic_aggregator.h"
+#include <algorithm>
+#include <climits>
+
+TrafficAggregator::TrafficAggregator(double interval_duration, double max_gap_seconds)
+    : interval_duration(interval_duration), origin(0.0), has_origin(false),
+      base_interval(0), head(0), newest_interval(LLONG_MIN), emitted_until(LLONG_MIN),
+      packet_count(0), late_packets(0), out_of_range_packets(0) {
+    double gap = std::ceil(max_gap_seconds / interval_duration);
+    max_gap_intervals = gap >= 1.0 ? static_cast<long long>(std::min(gap, static_cast<double>(MAX_BUCKETS))) : 1;
+}
+
+void TrafficAggregator::setOrigin(double origin_time) {
+    origin = origin_time;
+    has_origin = true;
+}
+
+void TrafficAggregator::reserveRange(double first_time, double last_time) {
+    if (!buckets.empty()) return;
+    if (!has_origin) setOrigin(first_time);
+
+    double lo = std::floor((std::min(first_time, last_time) - origin) / interval_duration);
+    double hi = std::floor((std::max(first_time, last_time) - origin) / interval_duration);
+    if (!(lo > -static_cast<double>(MAX_BUCKETS) && hi < static_cast<double>(MAX_BUCKETS))) return;
+    // Timestamp pertama/terakhir yang rusak tidak boleh memicu alokasi besar;
+    // tanpa cadangan array tetap tumbuh bertahap
+    if (hi - lo + 1 > static_cast<double>(MAX_RESERVED_BUCKETS)) return;
+
+    base_interval = static_cast<long long>(lo);
+    head = 0;
+    buckets.resize(static_cast<size_t>(hi - lo) + 1);
+    absorbOutliers();
+}
+
+TrafficAggregator::Bucket* TrafficAggregator::bucketFor(long long interval_id) {
+    if (buckets.empty()) {
+        base_interval = interval_id;
+        head = 0;
+        buckets.resize(1);
+        absorbOutliers();
+        return &buckets[0];
+    }
+
+    long long offset = interval_id - base_interval;
+    long long size = static_cast<long long>(buckets.size());
+    long long first = static_cast<long long>(head);
+    if (offset >= first && offset < size) return &buckets[static_cast<size_t>(offset)];
+
+    // Di luar array padat: perluas hanya sejauh celah maksimum atau rentang
+    // yang sudah teramati; interval yang lebih jauh masuk peta jarang
+    long long live = size - first;
+    long long distance = offset < first ? first - offset : offset - (size - 1);
+    bool dense = distance <= std::max(max_gap_intervals, live) && live + distance <= MAX_BUCKETS &&
+                 (offset >= 0 || head == 0);
+    if (!dense) return &outliers[interval_id];
+
+    if (offset < 0) {
+        growFront(static_cast<size_t>(-offset));
+        offset = interval_id - base_interval;
+    } else {
+        buckets.resize(static_cast<size_t>(offset) + 1);
+    }
+    absorbOutliers();
+    return &buckets[static_cast<size_t>(offset)];
+}
+
+void TrafficAggregator::growFront(size_t needed) {
+    // Paket yang makin awal memperluas array ke depan; ruang kosong disisakan
+    // sebanding dengan ukuran array sehingga pergeseran diamortisasi O(1)
+    size_t extra = std::max(needed, buckets.size());
+    if (static_cast<long long>(buckets.size() + extra) > MAX_BUCKETS) extra = needed;
+    std::vector<Bucket> grown(buckets.size() + extra);
+    std::copy(buckets.begin(), buckets.end(), grown.begin() + static_cast<std::ptrdiff_t>(extra));
+    buckets.swap(grown);
+    base_interval -= static_cast<long long>(extra);
+}
+
+void TrafficAggregator::absorbOutliers() {
+    // Interval jarang yang kini tercakup array padat dipindahkan ke sana
+    if (outliers.empty()) return;
+    long long first = base_interval + static_cast<long long>(head);
+    long long end = base_interval + static_cast<long long>(buckets.size());
+    for (auto it = outliers.lower_bound(first); it != outliers.end() && it->first < end;) {
+        Bucket& bucket = buckets[static_cast<size_t>(it->first - base_interval)];
+        bucket.total_bytes += it->second.total_bytes;
+        bucket.packet_count += it->second.packet_count;
+        it = outliers.erase(it);
+    }
+}
+
+void TrafficAggregator::merge(const TrafficAggregator& other) {
+    // Kedua agregator harus memakai titik awal dan lebar interval yang sama
+    for (size_t i = other.head; i < other.buckets.size(); i++) {
+        const Bucket& source = other.buckets[i];
+        if (source.packet_count == 0) continue;
+
+        long long interval_id = other.base_interval + static_cast<long long>(i);
+        Bucket* bucket = bucketFor(interval_id);
+        bucket->total_bytes += source.total_bytes;
+        bucket->packet_count += source.packet_count;
+        if (interval_id > newest_interval) newest_interval = interval_id;
+    }
+    for (const auto& entry : other.outliers) {
+        Bucket* bucket = bucketFor(entry.first);
+        bucket->total_bytes += entry.second.total_bytes;
+        bucket->packet_count += entry.second.packet_count;
+        if (entry.first > newest_interval) newest_interval = entry.first;
+    }
+    packet_count += other.packet_count;
+    late_packets += other.late_packets;
+    out_of_range_packets += other.out_of_range_packets;
+}
+
+void TrafficAggregator::compact() {
+    // Buang ember yang sudah dikeluarkan agar memori mode follow tetap kecil
+    if (head == buckets.size()) {
+        base_interval += static_cast<long long>(head);
+        buckets.clear();
+        head = 0;
+    } else if (head >= 4096 && head * 2 >= buckets.size()) {
+        buckets.erase(buckets.begin(), buckets.begin() + static_cast<std::ptrdiff_t>(head));
+        base_interval += static_cast<long long>(head);
+        head = 0;
+    }
+}
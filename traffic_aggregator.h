@@ -0,0 +1,138 @@
+#ifndef TRAFFIC_AGGREGATOR_H
+#define TRAFFIC_AGGREGATOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+// Agregator streaming: setiap paket langsung dilipat ke ember intervalnya
+// sehingga memori sebanding dengan jumlah interval, bukan jumlah paket.
+// Ember disimpan sebagai array padat yang diindeks langsung dengan
+// interval_id, tanpa pencarian pohon maupun alokasi per interval.
+//
+// Array padat hanya diperluas sejauh max(celah maksimum, rentang yang sudah
+// teramati). Interval yang lebih jauh (misalnya satu timestamp dengan jam
+// yang melompat bertahun-tahun) disimpan terpisah dalam peta jarang,
+// sehingga tetap dihitung tanpa memicu alokasi sebesar rentangnya.
+class TrafficAggregator {
+public:
+    struct Bucket {
+        long long total_bytes = 0;
+        long long packet_count = 0;
+    };
+
+    // Paket yang lebih jauh dari ini dari titik awal diabaikan
+    static constexpr long long MAX_BUCKETS = 1LL << 27;
+    // reserveRange tidak mengalokasikan lebih dari ini (64 MB)
+    static constexpr long long MAX_RESERVED_BUCKETS = 1LL << 22;
+    static constexpr double DEFAULT_MAX_GAP_SECONDS = 7 * 86400.0;
+
+private:
+    double interval_duration;
+    double origin;              // Awal interval nol (timestamp paket pertama)
+    bool has_origin;
+    long long base_interval;    // interval_id untuk buckets[0]
+    size_t head;                // Ember sebelum indeks ini sudah dikeluarkan
+    std::vector<Bucket> buckets;
+    long long max_gap_intervals;
+    std::map<long long, Bucket> outliers;   // Interval di luar jangkauan array padat
+    long long newest_interval;  // Interval terbaru yang pernah menerima paket
+    long long emitted_until;    // Semua interval < nilai ini sudah dikeluarkan
+    size_t packet_count;
+    size_t late_packets;        // Paket untuk interval yang sudah dikeluarkan
+    size_t out_of_range_packets; // Paket yang melampaui MAX_BUCKETS dari titik awal
+
+public:
+    explicit TrafficAggregator(double interval_duration = 300.0,
+                               double max_gap_seconds = DEFAULT_MAX_GAP_SECONDS);
+
+    // Tetapkan titik awal secara eksplisit (dipakai oleh ingest paralel)
+    void setOrigin(double origin_time);
+
+    // Alokasikan ember untuk rentang timestamp yang sudah diketahui
+    void reserveRange(double first_time, double last_time);
+
+    void addPacket(double timestamp, long long length) {
+        if (!has_origin && std::isfinite(timestamp)) setOrigin(timestamp);
+        double position = (timestamp - origin) / interval_duration;
+        if (!(std::fabs(position) < static_cast<double>(MAX_BUCKETS))) {
+            out_of_range_packets++;
+            return;
+        }
+        long long interval_id = static_cast<long long>(std::floor(position));
+        if (interval_id < emitted_until) {
+            late_packets++;
+            return;
+        }
+        Bucket* bucket = bucketFor(interval_id);
+        bucket->total_bytes += length;
+        bucket->packet_count += 1;
+        packet_count++;
+        if (interval_id > newest_interval) newest_interval = interval_id;
+    }
+
+    void merge(const TrafficAggregator& other);
+
+    // Keluarkan interval yang sudah pasti selesai (lebih lama dari interval terbaru).
+    // emit(interval_start, total_bytes, packet_count)
+    template <typename Emit>
+    size_t emitCompleted(Emit&& emit) {
+        return emitBefore(newest_interval, emit);
+    }
+
+    // Keluarkan semua interval yang tersisa, termasuk yang masih terbuka
+    template <typename Emit>
+    size_t emitAll(Emit&& emit) {
+        long long limit = base_interval + static_cast<long long>(buckets.size());
+        if (!outliers.empty() && outliers.rbegin()->first >= limit) limit = outliers.rbegin()->first + 1;
+        return emitBefore(limit, emit);
+    }
+
+    double getIntervalDuration() const { return interval_duration; }
+    bool hasOrigin() const { return has_origin; }
+    double getOrigin() const { return origin; }
+    size_t getPacketCount() const { return packet_count; }
+    size_t getLatePackets() const { return late_packets; }
+    size_t getOutOfRangePackets() const { return out_of_range_packets; }
+    size_t getOutlierIntervals() const { return outliers.size(); }
+    size_t getOpenIntervals() const { return buckets.size() - head + outliers.size(); }
+
+private:
+    Bucket* bucketFor(long long interval_id);   // Tidak pernah nullptr
+    void growFront(size_t needed);
+    void absorbOutliers();
+
+    template <typename Emit>
+    size_t emitBefore(long long interval_limit, Emit& emit) {
+        size_t emitted = 0;
+        // Array padat dan peta jarang tidak pernah memuat interval yang sama;
+        // keduanya dikeluarkan berurutan menurut interval_id
+        while (true) {
+            long long dense_id = head < buckets.size() ? base_interval + static_cast<long long>(head)
+                                                       : interval_limit;
+            bool from_outliers = !outliers.empty() && outliers.begin()->first < dense_id;
+            long long interval_id = from_outliers ? outliers.begin()->first : dense_id;
+            if (interval_id >= interval_limit) break;
+
+            const Bucket& bucket = from_outliers ? outliers.begin()->second : buckets[head];
+            // Interval tanpa paket tidak dikeluarkan, sama seperti versi map
+            if (bucket.packet_count > 0) {
+                emit(origin + interval_id * interval_duration, bucket.total_bytes, bucket.packet_count);
+                emitted++;
+            }
+            if (from_outliers) {
+                outliers.erase(outliers.begin());
+            } else {
+                head++;
+            }
+        }
+        if (interval_limit > emitted_until) emitted_until = interval_limit;
+        compact();
+        return emitted;
+    }
+
+    void compact();
+};
+
+#endif // TRAFFIC_AGGREGATOR_H
@@ -0,0 +1,97 @@
+#include "traffic_statistics.h"
+#include <cmath>
+
+namespace {
+
+const size_t LANES = 4;
+
+// Akumulator per jalur; nilai digeser dengan nilai pertama agar
+// penjumlahan kuadrat tidak kehilangan presisi (cancellation)
+struct Lanes {
+    double min[LANES];
+    double max[LANES];
+    double sum[LANES];
+    double sum_sq[LANES];
+
+    explicit Lanes(double first) {
+        for (size_t l = 0; l < LANES; l++) {
+            min[l] = first;
+            max[l] = first;
+            sum[l] = 0.0;
+            sum_sq[l] = 0.0;
+        }
+    }
+
+    void add(size_t lane, double value, double shift) {
+        double d = value - shift;
+        min[lane] = value < min[lane] ? value : min[lane];
+        max[lane] = value > max[lane] ? value : max[lane];
+        sum[lane] += d;
+        sum_sq[lane] += d * d;
+    }
+};
+
+void accumulate(const double* values, size_t count, double shift, Lanes& lanes) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (size_t l = 0; l < LANES; l++) {
+            lanes.add(l, values[i + l], shift);
+        }
+    }
+    for (; i < count; i++) {
+        lanes.add(0, values[i], shift);
+    }
+}
+
+} // namespace
+
+TrafficStatistics computeTrafficStatistics(const double* values, size_t count) {
+    TrafficStatistics stats;
+    if (count == 0 || values == nullptr) return stats;
+
+    double shift = values[0];
+    Lanes lanes(shift);
+    accumulate(values, count, shift, lanes);
+
+    double min = lanes.min[0], max = lanes.max[0], sum = 0.0, sum_sq = 0.0;
+    for (size_t l = 0; l < LANES; l++) {
+        min = lanes.min[l] < min ? lanes.min[l] : min;
+        max = lanes.max[l] > max ? lanes.max[l] : max;
+        sum += lanes.sum[l];
+        sum_sq += lanes.sum_sq[l];
+    }
+
+    double n = static_cast<double>(count);
+    double shifted_mean = sum / n;
+    double variance = sum_sq / n - shifted_mean * shifted_mean;
+
+    stats.count = count;
+    stats.min = min;
+    stats.max = max;
+    stats.mean = shift + shifted_mean;
+    stats.variance = variance > 0.0 ? variance : 0.0;
+    stats.stddev = std::sqrt(stats.variance);
+    stats.peak_to_average = stats.mean != 0.0 ? stats.max / stats.mean : 0.0;
+    return stats;
+}
+
+TrafficStatistics mergeTrafficStatistics(const TrafficStatistics& a, const TrafficStatistics& b) {
+    if (a.count == 0) return b;
+    if (b.count == 0) return a;
+
+    double na = static_cast<double>(a.count);
+    double nb = static_cast<double>(b.count);
+    double n = na + nb;
+    double delta = b.mean - a.mean;
+
+    TrafficStatistics stats;
+    stats.count = a.count + b.count;
+    stats.min = a.min < b.min ? a.min : b.min;
+    stats.max = a.max > b.max ? a.max : b.max;
+    stats.mean = a.mean + delta * (nb / n);
+    double m2 = a.variance * na + b.variance * nb + delta * delta * (na * nb / n);
+    stats.variance = m2 > 0.0 ? m2 / n : 0.0;
+    stats.stddev = std::sqrt(stats.variance);
+    stats.peak_to_average = stats.mean != 0.0 ? stats.max / stats.mean : 0.0;
+    return stats;
+}
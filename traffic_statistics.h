@@ -0,0 +1,26 @@
+#ifndef TRAFFIC_STATISTICS_H
+#define TRAFFIC_STATISTICS_H
+
+#include <cstddef>
+
+// Ringkasan statistik deret bandwidth
+struct TrafficStatistics {
+    size_t count = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double variance = 0.0;        // Variansi populasi
+    double stddev = 0.0;
+    double peak_to_average = 0.0; // max / mean
+};
+
+// Hitung semua statistik dalam satu lintasan atas array rapat. Nilai
+// diakumulasi dalam beberapa jalur independen agar kompiler dapat
+// memvektorisasi loop.
+TrafficStatistics computeTrafficStatistics(const double* values, size_t count);
+
+// Gabungkan ringkasan dua deret terpisah seolah-olah dihitung atas gabungan
+// keduanya (rumus variansi gabungan Chan dkk.)
+TrafficStatistics mergeTrafficStatistics(const TrafficStatistics& a, const TrafficStatistics& b);
+
+#endif // TRAFFIC_STATISTICS_H